@@ -0,0 +1,104 @@
+// Compares fmap and bind over a std::unordered_set far larger than the last-level cache with their bucketwise
+// counterparts, which walk the nodes bucket by bucket, a prefetched batch at a time, rather than in iteration order.
+//
+// Usage: bucketwise_benchmark [nodes, by default 2^21] [repetitions, by default 3]
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <kitten/bucketwise.h>
+#include <kitten/functor.h>
+#include <kitten/instances/set_container.h>
+#include <kitten/monad.h>
+#include <random>
+#include <unordered_set>
+
+namespace {
+
+using namespace rvarago::kitten;
+
+/**
+ * A record that spans four cache lines, of which the functions read one word each.
+ */
+struct record {
+    std::array<std::uint64_t, 32> words;
+
+    friend bool operator==(record const &first, record const &second) {
+        return first.words[0] == second.words[0];
+    }
+};
+
+}
+
+namespace std {
+template <>
+struct hash<record> {
+    std::size_t operator()(record const &r) const noexcept {
+        return std::hash<std::uint64_t>{}(r.words[0]);
+    }
+};
+}
+
+namespace {
+
+std::uint64_t checksum(record const &r) {
+    return r.words[0] ^ r.words[8] ^ r.words[16] ^ r.words[24];
+}
+
+/**
+ * @return a set of size records with random keys, inserted one at a time, such that it's rehashed as it grows
+ */
+std::unordered_set<record> random_set(std::size_t size) {
+    auto values = std::unordered_set<record>{};
+    auto random = std::mt19937_64{42};
+    while (values.size() < size) {
+        auto r = record{};
+        std::fill(r.words.begin(), r.words.end(), random());
+        values.insert(r);
+    }
+    return values;
+}
+
+/**
+ * @return the fastest time of repetitions runs of f, in nanoseconds per node
+ */
+template <typename Function>
+double best_of(std::size_t repetitions, std::size_t size, Function f) {
+    auto best = 1e300;
+    for (std::size_t i = 0; i < repetitions; ++i) {
+        auto const start = std::chrono::steady_clock::now();
+        f();
+        auto const elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+        best = std::min(best, elapsed.count() / static_cast<double>(size));
+    }
+    return best;
+}
+
+volatile std::size_t sink;
+
+}
+
+int main(int argc, char **argv) {
+    auto const size = argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : std::size_t{1} << 21;
+    auto const repetitions = argc > 2 ? static_cast<std::size_t>(std::strtoull(argv[2], nullptr, 10)) : 3;
+
+    auto const values = random_set(size);
+    auto const low_bits = [](record const &r) { return checksum(r) & 0xFFFF; };
+    auto const around = [](record const &r) { return std::unordered_set<std::uint64_t>{checksum(r) & 0xFFFF}; };
+
+    std::printf("%zu nodes of %zu bytes, best of %zu runs\n\n", size, sizeof(record), repetitions);
+    std::printf("%-12s %12s %12s\n", "traversal", "fmap ns/node", "bind ns/node");
+
+    auto const plain_fmap = best_of(repetitions, size, [&] { sink = fmap(values, low_bits).size(); });
+    auto const plain_bind = best_of(repetitions, size, [&] { sink = bind(values, around).size(); });
+    std::printf("%-12s %12.1f %12.1f\n", "iteration", plain_fmap, plain_bind);
+
+    auto const bucketwise_fmap = best_of(repetitions, size, [&] { sink = fmap_bucketwise(values, low_bits).size(); });
+    auto const bucketwise_bind = best_of(repetitions, size, [&] { sink = bind_bucketwise(values, around).size(); });
+    std::printf("%-12s %12.1f %12.1f\n", "bucketwise", bucketwise_fmap, bucketwise_bind);
+}
@@ -3,6 +3,8 @@
 
 #include <functional>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace rvarago::kitten {
 
@@ -37,6 +39,19 @@ constexpr decltype(auto) pure(A &&value) {
     return applicative<AP>::pure(std::forward<A>(value));
 }
 
+/**
+ * Lifts a value of type A, constructed in place from args, into an applicative AP[A], such that move-only or expensive
+ * to move values are never materialized outside of the applicative.
+ *
+ * @param args the arguments forwarded to the constructor of A
+ * @return a new applicative ap: AP[A] that wraps the value of type A constructed from args
+ */
+template <template <typename...> typename AP, typename A, typename... Args>
+constexpr decltype(auto) pure_in_place(Args &&... args) {
+    static_assert(traits::is_applicative_v<AP>, "type constructor AP does not have an applicative instance");
+    return applicative<AP>::template pure_in_place<A>(std::forward<Args>(args)...);
+}
+
 /**
  * Unwraps the applicatives apa: AP[A] and apb: AP[B], feeds the unwrapped value of types A and B into the function
  * f: (A, B) -> C, and then returns its result wrapped in a functor F[B]..
@@ -47,8 +62,10 @@ constexpr decltype(auto) pure(A &&value) {
  * @return a new applicative apc: AP[C] resulting from wrapping the application of f over the wrapped value inside apa
  * and apb
  */
-template <template <typename...> typename AP, typename A, typename B, typename BinaryFunction = std::plus<>>
-constexpr decltype(auto) combine(AP<A> const &first, AP<B> const &second, BinaryFunction f = BinaryFunction{}) {
+template <template <typename...> typename AP, typename A, typename... RestA, typename B, typename... RestB,
+          typename BinaryFunction = std::plus<>>
+constexpr decltype(auto) combine(AP<A, RestA...> const &first, AP<B, RestB...> const &second,
+                                 BinaryFunction f = BinaryFunction{}) {
     static_assert(traits::is_applicative_v<AP>, "type constructor AP does not have an applicative instance");
     return applicative<AP>::combine(first, second, f);
 }
@@ -56,16 +73,17 @@ constexpr decltype(auto) combine(AP<A> const &first, AP<B> const &second, Binary
 /**
  * Infix version of combine. Since operator+ expects two arguments, we had to wrap the applicatives in a tuple.
  */
-template <template <typename...> typename AP, typename A, typename B, typename BinaryFunction>
-constexpr decltype(auto) operator+(std::tuple<AP<A>, AP<B>> const &input, BinaryFunction f) {
+template <template <typename...> typename AP, typename A, typename... RestA, typename B, typename... RestB,
+          typename BinaryFunction>
+constexpr decltype(auto) operator+(std::tuple<AP<A, RestA...>, AP<B, RestB...>> const &input, BinaryFunction f) {
     return combine(std::get<0>(input), std::get<1>(input), f);
 }
 
 /**
  * Infix version of combine that receives unwrapped applicatives and uses + as a binary function.
  */
-template <template <typename...> typename AP, typename A, typename B>
-constexpr decltype(auto) operator+(AP<A> const &first, AP<B> const &second) {
+template <template <typename...> typename AP, typename A, typename... RestA, typename B, typename... RestB>
+constexpr decltype(auto) operator+(AP<A, RestA...> const &first, AP<B, RestB...> const &second) {
     return combine(first, second);
 }
 
@@ -0,0 +1,60 @@
+#ifndef RVARAGO_KITTEN_BUCKETWISE_H
+#define RVARAGO_KITTEN_BUCKETWISE_H
+
+#include <type_traits>
+#include <utility>
+
+#include "kitten/functor.h"
+#include "kitten/monad.h"
+
+#include "kitten/instances/set_container.h"
+
+#include "kitten/detail/ranges/bucketwise.h"
+
+namespace rvarago::kitten {
+
+/**
+ * Maps input via f like fmap does, but walks the nodes of input bucket by bucket, a batch at a time, rather than
+ * following the list that threads them in iteration order: the nodes of a batch are reached independently of each
+ * other, so their cache misses overlap. It pays off for hash containers that don't fit in the cache, and it calls f in
+ * bucket order.
+ *
+ * Sequences and ordered sets, e.g. std::list or std::set, are a single chain of nodes, each one reached from the
+ * previous one, so there's no independent walk to offer for them.
+ *
+ * @param input a hash container of values of type A with a functor instance, e.g. an std::unordered_set
+ * @param f a function A -> B
+ * @return the same as fmap(input, f)
+ */
+template <template <typename...> typename Container, typename A, typename... Rest, typename UnaryFunction>
+auto fmap_bucketwise(Container<A, Rest...> const &input, UnaryFunction f) {
+    static_assert(traits::is_functor_v<Container>, "type constructor Container does not have a functor instance");
+    static_assert(detail::ranges::has_buckets_v<Container<A, Rest...>>, "input must be a hash container");
+    auto mapped = std::decay_t<decltype(functor<Container>::fmap(input, f))>{};
+    detail::sets::reserve(mapped, input.size());
+    auto map = [&mapped, &f](auto const &e) { mapped.insert(f(e)); };
+    detail::ranges::for_each_bucketwise(input, map);
+    return mapped;
+}
+
+/**
+ * Binds input to f like bind does, but walks the nodes of input bucket by bucket, as fmap_bucketwise does. The inner
+ * sets are inserted into the output as bind does, i.e. their nodes are moved when f returns them by value.
+ *
+ * @param input a hash container of values of type A with a monad instance, e.g. an std::unordered_set
+ * @param f a function A -> Container[B]
+ * @return the same as bind(input, f)
+ */
+template <template <typename...> typename Container, typename A, typename... Rest, typename UnaryFunction>
+auto bind_bucketwise(Container<A, Rest...> const &input, UnaryFunction f) {
+    static_assert(traits::is_monad_v<Container>, "type constructor Container does not have a monad instance");
+    static_assert(detail::ranges::has_buckets_v<Container<A, Rest...>>, "input must be a hash container");
+    auto mapped = std::decay_t<decltype(f(std::declval<A>()))>{};
+    auto expand = [&mapped, &f](auto const &e) { detail::sets::insert(mapped, f(e)); };
+    detail::ranges::for_each_bucketwise(input, expand);
+    return mapped;
+}
+
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef RVARAGO_KITTEN_COMONAD_H
+#define RVARAGO_KITTEN_COMONAD_H
+
+#include <type_traits>
+#include <utility>
+
+namespace rvarago::kitten {
+
+/**
+ * A comonad is the dual of a monad: rather than wrapping a value into a context, it extracts the value in focus out
+ * of a context, and rather than feeding each value into a function that returns a new context, it feeds each context
+ * into a function that returns a value.
+ *
+ * Given a comonad wa: W[A] and a function f: W[A] -> B
+ *  It moves the focus through each position of wa, feeds the comonad focused at that position into f, and then
+ *  returns a new comonad wb: W[B] with the results at the same positions.
+ *
+ * Laws:
+ *
+ * - Left identity: extend(w, extract) == w
+ * - Right identity: extract(extend(w, f)) == f(w)
+ * - Associativity: extend(extend(w, f), g) == extend(w, (\x -> g(extend(x, f))))
+ */
+template <template <typename...> typename W, typename = void>
+struct comonad;
+
+namespace traits {
+template <template <typename...> typename, typename = void>
+struct is_comonad : std::false_type {};
+
+template <template <typename...> typename W>
+inline constexpr bool is_comonad_v = is_comonad<W>::value;
+}
+
+/**
+ * Extracts the value of type A in focus out of the comonad wa: W[A].
+ *
+ * @param input a comonad wa: W[A]
+ * @return the value of type A in focus
+ */
+template <template <typename...> typename W, typename A>
+constexpr decltype(auto) extract(W<A> const &input) {
+    static_assert(traits::is_comonad_v<W>, "type constructor W does not have a comonad instance");
+    return comonad<W>::extract(input);
+}
+
+/**
+ * Feeds the comonad wa: W[A], focused at each of its positions, into the function f: W[A] -> B, and then returns a
+ * new comonad wb: W[B] with the results.
+ *
+ * @param input a comonad wa: W[A]
+ * @param f a function W[A] -> B that summarises the comonad focused at a position
+ * @return a new comonad wb: W[B] with the result of f for every position of wa
+ */
+template <template <typename...> typename W, typename A, typename UnaryFunction>
+constexpr decltype(auto) extend(W<A> const &input, UnaryFunction f) {
+    static_assert(traits::is_comonad_v<W>, "type constructor W does not have a comonad instance");
+    return comonad<W>::extend(input, f);
+}
+
+/**
+ * Nests the comonad wa: W[A] into a comonad W[W[A]] holding wa focused at each of its positions, i.e.
+ * extend(wa, identity).
+ *
+ * @param input a comonad wa: W[A]
+ * @return a new comonad W[W[A]] with wa focused at every position
+ */
+template <template <typename...> typename W, typename A>
+constexpr decltype(auto) duplicate(W<A> const &input) {
+    static_assert(traits::is_comonad_v<W>, "type constructor W does not have a comonad instance");
+    return comonad<W>::extend(input, [](auto const &focused) { return focused; });
+}
+
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef RVARAGO_KITTEN_FORK_JOIN_H
+#define RVARAGO_KITTEN_FORK_JOIN_H
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace rvarago::kitten::detail::concurrency {
+
+/**
+ * @return the number of threads that run concurrently on this machine, at least one
+ */
+inline std::size_t default_threads() noexcept {
+    return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+/**
+ * Runs task(0), ..., task(tasks - 1) concurrently, the last one on the calling thread, and waits for all of them.
+ *
+ * If any task throws, the exception of the lowest failing task is rethrown once every task is done. If a thread can't
+ * be started, the threads started so far are joined before rethrowing its std::system_error, and the calling thread
+ * runs no task.
+ */
+template <typename Task>
+void fork_join(std::size_t tasks, Task const &task) {
+    auto errors = std::vector<std::exception_ptr>(tasks);
+    auto guarded = [&errors, &task](std::size_t i) noexcept {
+        try {
+            task(i);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+    auto workers = std::vector<std::thread>{};
+    workers.reserve(tasks);
+    try {
+        for (std::size_t i = 0; i + 1 < tasks; ++i) {
+            workers.emplace_back(guarded, i);
+        }
+    } catch (...) {
+        for (auto &worker : workers) {
+            worker.join();
+        }
+        throw;
+    }
+    if (tasks > 0) {
+        guarded(tasks - 1);
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    for (auto const &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef RVARAGO_KITTEN_SPSC_CHANNEL_H
+#define RVARAGO_KITTEN_SPSC_CHANNEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace rvarago::kitten::detail::concurrency {
+
+inline constexpr std::size_t cache_line_size = 64;
+
+/**
+ * A bounded lock-free ring buffer connecting exactly one producer thread to exactly one consumer thread.
+ *
+ * The producer closes the channel once it's done, and the consumer still drains whatever was pushed before that.
+ */
+template <typename T>
+class spsc_channel {
+  public:
+    explicit spsc_channel(std::size_t capacity) : slots(std::max<std::size_t>(capacity, 1)) {
+    }
+
+    spsc_channel(spsc_channel const &) = delete;
+    spsc_channel &operator=(spsc_channel const &) = delete;
+
+    bool try_push(T &value) {
+        auto const current_tail = tail.load(std::memory_order_relaxed);
+        if (current_tail - head.load(std::memory_order_acquire) == slots.size()) {
+            return false;
+        }
+        slots[current_tail % slots.size()] = std::move(value);
+        tail.store(current_tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T &value) {
+        auto const current_head = head.load(std::memory_order_relaxed);
+        if (current_head == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        auto &slot = slots[current_head % slots.size()];
+        value = std::move(*slot);
+        slot.reset();
+        head.store(current_head + 1, std::memory_order_release);
+        return true;
+    }
+
+    void close() noexcept {
+        closed.store(true, std::memory_order_release);
+    }
+
+    bool is_closed() const noexcept {
+        return closed.load(std::memory_order_acquire);
+    }
+
+  private:
+    std::vector<std::optional<T>> slots;
+    alignas(cache_line_size) std::atomic<std::size_t> head{0};
+    alignas(cache_line_size) std::atomic<std::size_t> tail{0};
+    alignas(cache_line_size) std::atomic<bool> closed{false};
+};
+
+/**
+ * Waits between two attempts to access a channel: by yielding at first, and then by sleeping for exponentially longer,
+ * up to max_sleep, so that a stage that stays idle for long doesn't keep a core busy.
+ */
+class backoff {
+    static constexpr unsigned yields = 64;
+    static constexpr std::chrono::microseconds max_sleep{1000};
+
+    unsigned attempts{0};
+
+  public:
+    void wait() {
+        if (attempts < yields) {
+            std::this_thread::yield();
+        } else {
+            auto const doublings = std::min(attempts - yields, 10u);
+            std::this_thread::sleep_for(std::min(std::chrono::microseconds{1 << doublings}, max_sleep));
+        }
+        ++attempts;
+    }
+};
+
+/**
+ * Pushes value into the channel, waiting while it's full (backpressure), unless cancelled is raised meanwhile.
+ *
+ * @return whether value was pushed
+ */
+template <typename T>
+bool send(spsc_channel<T> &channel, T &value, std::atomic<bool> const &cancelled) {
+    auto pause = backoff{};
+    while (!channel.try_push(value)) {
+        if (cancelled.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        pause.wait();
+    }
+    return true;
+}
+
+/**
+ * Pops a value from the channel, waiting while it's empty, until it's closed and drained or cancelled is raised.
+ *
+ * @return whether a value was popped
+ */
+template <typename T>
+bool receive(spsc_channel<T> &channel, T &value, std::atomic<bool> const &cancelled) {
+    auto pause = backoff{};
+    while (!channel.try_pop(value)) {
+        if (cancelled.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        if (channel.is_closed()) {
+            return channel.try_pop(value);
+        }
+        pause.wait();
+    }
+    return true;
+}
+
+}
+
+#endif
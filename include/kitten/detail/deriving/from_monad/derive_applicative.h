@@ -4,6 +4,9 @@
 #include "kitten/applicative.h"
 #include "kitten/monad.h"
 
+#include <type_traits>
+#include <utility>
+
 namespace rvarago::kitten::detail::deriving {
 
 template <template <typename...> typename M, typename A, typename B, typename BinaryFunction>
@@ -17,11 +20,17 @@ constexpr auto combine(M<A> const &first, M<B> const &second, BinaryFunction f)
 }
 
 template <template <typename...> typename M, typename A>
-constexpr auto pure(A &&value) -> M<A> {
+constexpr auto pure(A &&value) -> M<std::decay_t<A>> {
     using MonadT = monad<M>;
     return MonadT::wrap(std::forward<A>(value));
 }
 
+template <template <typename...> typename M, typename A, typename... Args>
+constexpr auto pure_in_place(Args &&... args) -> M<A> {
+    using MonadT = monad<M>;
+    return MonadT::template wrap_in_place<A>(std::forward<Args>(args)...);
+}
+
 }
 
 #endif
@@ -0,0 +1,20 @@
+#ifndef RVARAGO_KITTEN_DERIVE_KLEISLI_H
+#define RVARAGO_KITTEN_DERIVE_KLEISLI_H
+
+#include "kitten/monad.h"
+
+#include <utility>
+
+namespace rvarago::kitten::detail::deriving {
+
+template <template <typename...> typename M, typename UnaryFunctionA, typename UnaryFunctionB>
+constexpr decltype(auto) compose(UnaryFunctionA f, UnaryFunctionB g) {
+    using MonadT = monad<M>;
+    return [f = std::move(f), g = std::move(g)](auto &&value) {
+        return MonadT::bind(f(std::forward<decltype(value)>(value)), g);
+    };
+}
+
+}
+
+#endif
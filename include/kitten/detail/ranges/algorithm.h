@@ -2,6 +2,9 @@
 #define RVARAGO_KITTEN_ALGORITHM_H
 
 #include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
 
 // TODO: Use standard ranges
 namespace rvarago::kitten::detail::ranges {
@@ -16,6 +19,75 @@ constexpr decltype(auto) for_each(Range &&range, UnaryFunction f) {
     return std::for_each(std::cbegin(range), std::cend(range), f);
 }
 
+/**
+ * Writes each value of range through write(value, *out), which returns whether it shall be kept, and only advances out
+ * for the kept values. Writing unconditionally and advancing by the returned flag keeps the loop free of
+ * unpredictable branches.
+ *
+ * @return the number of kept values
+ */
+template <typename Range, typename RandomAccessIterator, typename Writer>
+constexpr std::size_t compact(Range &&range, RandomAccessIterator out, Writer write) {
+    auto kept = std::size_t{0};
+    for (auto const &value : range) {
+        kept += static_cast<std::size_t>(write(value, out[kept]));
+    }
+    return kept;
+}
+
+/**
+ * A non-owning view over the values in [first, last), which are expected to be size apart.
+ */
+template <typename Iterator>
+class subrange {
+  public:
+    using value_type = typename std::iterator_traits<Iterator>::value_type;
+    using size_type = std::size_t;
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+
+    constexpr subrange(Iterator first, Iterator last, std::size_t count) : first_{first}, last_{last}, count_{count} {
+    }
+
+    constexpr Iterator begin() const {
+        return first_;
+    }
+
+    constexpr Iterator end() const {
+        return last_;
+    }
+
+    constexpr std::size_t size() const noexcept {
+        return count_;
+    }
+
+    constexpr bool empty() const noexcept {
+        return count_ == 0;
+    }
+
+    constexpr decltype(auto) front() const {
+        return *first_;
+    }
+
+  private:
+    Iterator first_;
+    Iterator last_;
+    std::size_t count_;
+};
+
+template <typename Range, typename Container>
+constexpr void append(Range &&range, Container &destination) {
+    if constexpr (std::is_rvalue_reference_v<Range &&> && std::is_same_v<std::decay_t<Range>, Container>) {
+        if (destination.empty()) {
+            destination = std::move(range);
+            return;
+        }
+        std::move(std::begin(range), std::end(range), std::back_inserter(destination));
+    } else {
+        copy(std::forward<Range>(range), std::back_inserter(destination));
+    }
+}
+
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,84 @@
+#ifndef RVARAGO_KITTEN_RANGES_BUCKETWISE_H
+#define RVARAGO_KITTEN_RANGES_BUCKETWISE_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace rvarago::kitten::detail::ranges {
+
+inline constexpr std::size_t prefetch_line_size = 64;
+
+/**
+ * The number of cache lines prefetched per value.
+ */
+inline constexpr std::size_t max_prefetch_lines = 8;
+
+/**
+ * The number of values whose nodes are gathered before any of them is fed into the function.
+ */
+inline constexpr std::size_t bucketwise_batch_size = 16;
+
+/**
+ * Hints that the cache lines of value are about to be read, without waiting for them.
+ */
+template <typename T>
+void prefetch(T const &value) noexcept {
+#if defined(__GNUC__)
+    auto const *first = reinterpret_cast<char const *>(std::addressof(value));
+    constexpr auto lines = std::min((sizeof(T) + prefetch_line_size - 1) / prefetch_line_size, max_prefetch_lines);
+    for (std::size_t line = 0; line < lines; ++line) {
+        __builtin_prefetch(first + line * prefetch_line_size, 0, 3);
+    }
+#else
+    (void)value;
+#endif
+}
+
+template <typename Range, typename = void>
+struct has_buckets : std::false_type {};
+
+template <typename Range>
+struct has_buckets<Range, std::void_t<decltype(std::declval<Range const &>().bucket_count()),
+                                      decltype(std::declval<Range const &>().begin(std::size_t{})),
+                                      decltype(std::declval<Range const &>().end(std::size_t{}))>> : std::true_type {};
+
+template <typename Range>
+inline constexpr bool has_buckets_v = has_buckets<Range>::value;
+
+/**
+ * Feeds each value of range into f bucket by bucket, rather than in iteration order, a batch of values at a time.
+ *
+ * Iterating a hash container follows the single list that threads every node, so each step waits on the previous
+ * one. A bucket, however, is reached from the bucket array, so the walks of consecutive buckets are independent of each
+ * other. Gathering the nodes of a batch, and prefetching their values, before feeding any of them into f keeps the
+ * misses of the whole batch in flight at once, however much work f does.
+ */
+template <typename Range, typename UnaryFunction>
+void for_each_bucketwise(Range const &range, UnaryFunction &f) {
+    auto batch = std::array<typename Range::value_type const *, bucketwise_batch_size>{};
+    auto gathered = std::size_t{0};
+    auto feed = [&batch, &gathered, &f] {
+        for (std::size_t i = 0; i < gathered; ++i) {
+            f(*batch[i]);
+        }
+        gathered = 0;
+    };
+    for (std::size_t bucket = 0, buckets = range.bucket_count(); bucket < buckets; ++bucket) {
+        for (auto e = range.begin(bucket), last = range.end(bucket); e != last; ++e) {
+            prefetch(*e);
+            batch[gathered++] = std::addressof(*e);
+            if (gathered == batch.size()) {
+                feed();
+            }
+        }
+    }
+    feed();
+}
+
+}
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef RVARAGO_KITTEN_BYTE_TABLE_H
+#define RVARAGO_KITTEN_BYTE_TABLE_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
+
+namespace rvarago::kitten::detail::simd {
+
+template <typename T>
+inline constexpr bool is_byte_v = sizeof(T) == 1 && std::is_trivially_copyable_v<T> &&
+                                  (std::is_integral_v<T> || std::is_enum_v<T>) && !std::is_same_v<T, bool>;
+
+using byte_table = std::array<std::uint8_t, 256>;
+
+/**
+ * Tabulates f: A -> B over every byte value, where A and B are byte-sized.
+ */
+template <typename A, typename UnaryFunction>
+byte_table tabulate(UnaryFunction const &f) {
+    auto table = byte_table{};
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        auto const input = static_cast<A>(static_cast<std::uint8_t>(i));
+        auto const output = f(input);
+        std::memcpy(&table[i], &output, 1);
+    }
+    return table;
+}
+
+/**
+ * Tells whether the running CPU, rather than the compilation target, has the AVX-512 VBMI byte permutes.
+ */
+inline bool supports_avx512vbmi() noexcept {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vbmi");
+#else
+    return false;
+#endif
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+/**
+ * Looks 64 bytes up at once: vpermi2b picks from either half of the table by the low 7 bits of each byte, and the high
+ * bit selects which half is kept. Returns how many leading bytes were looked up, leaving fewer than 64.
+ *
+ * Compiled for AVX-512 VBMI regardless of the target, so it must only be called when supports_avx512vbmi().
+ */
+__attribute__((target("avx512f,avx512bw,avx512vbmi"))) inline std::size_t
+lookup_avx512vbmi(std::uint8_t const *in, std::size_t size, std::uint8_t *out, byte_table const &table) noexcept {
+    auto const first_quarter = _mm512_loadu_si512(table.data());
+    auto const second_quarter = _mm512_loadu_si512(table.data() + 64);
+    auto const third_quarter = _mm512_loadu_si512(table.data() + 128);
+    auto const fourth_quarter = _mm512_loadu_si512(table.data() + 192);
+    auto i = std::size_t{0};
+    for (; i + 64 <= size; i += 64) {
+        auto const bytes = _mm512_loadu_si512(in + i);
+        auto const low_half = _mm512_permutex2var_epi8(first_quarter, bytes, second_quarter);
+        auto const high_half = _mm512_permutex2var_epi8(third_quarter, bytes, fourth_quarter);
+        _mm512_storeu_si512(out + i, _mm512_mask_blend_epi8(_mm512_movepi8_mask(bytes), low_half, high_half));
+    }
+    return i;
+}
+
+#else
+
+inline std::size_t lookup_avx512vbmi(std::uint8_t const *, std::size_t, std::uint8_t *, byte_table const &) noexcept {
+    return 0;
+}
+
+#endif
+
+/**
+ * Writes table[in[i]] into out[i] for every i in [0, size), one byte at a time.
+ */
+inline void lookup_scalar(std::uint8_t const *in, std::size_t size, std::uint8_t *out,
+                          byte_table const &table) noexcept {
+    for (std::size_t i = 0; i < size; ++i) {
+        out[i] = table[in[i]];
+    }
+}
+
+/**
+ * Writes table[in[i]] into out[i] for every i in [0, size), via lookup_avx512vbmi when the running CPU supports it,
+ * and lookup_scalar for the remaining bytes. in and out may alias.
+ */
+inline void lookup(void const *in, std::size_t size, void *out, byte_table const &table) noexcept {
+    static bool const vectorized = supports_avx512vbmi();
+    auto const *first = static_cast<std::uint8_t const *>(in);
+    auto *result = static_cast<std::uint8_t *>(out);
+    auto const done = vectorized ? lookup_avx512vbmi(first, size, result, table) : std::size_t{0};
+    lookup_scalar(first + done, size - done, result + done, table);
+}
+
+/**
+ * Looks the size bytes of in up in table a chunk at a time, through a buffer of B that stays in the L1 cache, and hands
+ * each chunk to append(first, last). The output is then written once, by append, rather than zero-filled beforehand to
+ * make room for lookup.
+ */
+template <typename B, typename ChunkFunction>
+void lookup_chunks(void const *in, std::size_t size, byte_table const &table, ChunkFunction append) {
+    B buffer[4096];
+    auto const *first = static_cast<std::uint8_t const *>(in);
+    for (std::size_t done = 0; done < size;) {
+        auto const count = std::min(size - done, std::size(buffer));
+        lookup(first + done, count, buffer, table);
+        append(std::cbegin(buffer), std::cbegin(buffer) + count);
+        done += count;
+    }
+}
+
+}
+
+#endif
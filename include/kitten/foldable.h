@@ -0,0 +1,44 @@
+#ifndef RVARAGO_KITTEN_FOLDABLE_H
+#define RVARAGO_KITTEN_FOLDABLE_H
+
+#include <type_traits>
+#include <utility>
+
+namespace rvarago::kitten {
+
+/**
+ * A foldable is an abstraction that allows its wrapped values to be reduced into a single summary value.
+ *
+ * Given a foldable fa: F[A], an initial value b: B, and a binary function f: (B, A) -> B
+ *  It feeds each value unwrapped from fa, from left to right, together with the accumulated value into f, and then
+ *  returns the final accumulated value of type B.
+ */
+template <template <typename...> typename F, typename = void>
+struct foldable;
+
+namespace traits {
+template <template <typename...> typename, typename = void>
+struct is_foldable : std::false_type {};
+
+template <template <typename...> typename F>
+inline constexpr bool is_foldable_v = is_foldable<F>::value;
+}
+
+/**
+ * Unwraps the foldable fa: F[A] and accumulates each unwrapped value of type A, from left to right, into init via
+ * the function f: (B, A) -> B.
+ *
+ * @param input a foldable fa: F[A]
+ * @param init the initial value b: B of the accumulation, returned as is when fa is empty
+ * @param f a function (B, A) -> B that accumulates the value unwrapped from fa into the accumulated value
+ * @return the accumulated value b: B after feeding every value unwrapped from fa into f
+ */
+template <template <typename...> typename F, typename A, typename B, typename BinaryFunction>
+constexpr decltype(auto) fold(F<A> const &input, B init, BinaryFunction f) {
+    static_assert(traits::is_foldable_v<F>, "type constructor F does not have a foldable instance");
+    return foldable<F>::fold(input, std::move(init), f);
+}
+
+}
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef RVARAGO_KITTEN_FUNCTOR_H
 #define RVARAGO_KITTEN_FUNCTOR_H
 
+#include <type_traits>
+
 namespace rvarago::kitten {
 
 /**
@@ -33,8 +35,8 @@ inline constexpr bool is_functor_v = is_functor<F>::value;
  * @param f a function A -> B that maps over the value unwrapped from fa to yield a value b: B
  * @return a new functor fb: F[B] resulting from wrapping the application of f over the unwrapped value from fa
  */
-template <template <typename...> typename F, typename A, typename UnaryFunction>
-constexpr decltype(auto) fmap(F<A> const &input, UnaryFunction f) {
+template <template <typename...> typename F, typename A, typename... Rest, typename UnaryFunction>
+constexpr decltype(auto) fmap(F<A, Rest...> const &input, UnaryFunction f) {
     static_assert(traits::is_functor_v<F>, "type constructor F does not have a functor instance");
     return functor<F>::fmap(input, f);
 }
@@ -42,8 +44,8 @@ constexpr decltype(auto) fmap(F<A> const &input, UnaryFunction f) {
 /**
  * Infix version of fmap.
  */
-template <template <typename...> typename F, typename A, typename UnaryFunction>
-constexpr decltype(auto) operator|(F<A> const &input, UnaryFunction f) {
+template <template <typename...> typename F, typename A, typename... Rest, typename UnaryFunction>
+constexpr decltype(auto) operator|(F<A, Rest...> const &input, UnaryFunction f) {
     return fmap(input, f);
 }
 
@@ -0,0 +1,277 @@
+#ifndef RVARAGO_KITTEN_GROUP_FOLD_H
+#define RVARAGO_KITTEN_GROUP_FOLD_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "kitten/instances/sequence_container.h"
+
+#include "kitten/detail/concurrency/fork_join.h"
+
+namespace rvarago::kitten {
+
+namespace detail::grouping {
+
+/**
+ * Scrambles a hash, since std::hash is the identity for integers on common implementations, whereas the partitions
+ * and the probe sequences are picked from its high and low bits respectively.
+ */
+constexpr std::uint64_t mix(std::size_t hash) noexcept {
+    auto mixed = static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull;
+    return mixed ^ (mixed >> 29);
+}
+
+/**
+ * @return the partition of a mixed hash among partitions, taken from its high 32 bits
+ */
+constexpr std::size_t partition_of(std::uint64_t mixed, std::size_t partitions) noexcept {
+    return static_cast<std::size_t>(((mixed >> 32) * partitions) >> 32);
+}
+
+/**
+ * An open-addressing hash table with linear probing that aggregates the values with the same key, and keeps the mixed
+ * hash of each entry so that it's neither recomputed when growing nor when merging into another table.
+ */
+template <typename K, typename V, typename KeyEqual>
+class flat_table {
+  public:
+    using entry = std::pair<K, V>;
+
+    std::size_t size() const noexcept {
+        return count;
+    }
+
+    /**
+     * Folds value into the entry of key via combine, or inserts it if key is absent.
+     */
+    template <typename BinaryFunction>
+    void accumulate(std::uint64_t mixed, K &&key, V &&value, BinaryFunction &combine) {
+        if ((count + 1) * 2 > slots.size()) {
+            grow();
+        }
+        auto const mask = slots.size() - 1;
+        for (auto i = static_cast<std::size_t>(mixed) & mask;; i = (i + 1) & mask) {
+            auto &slot = slots[i];
+            if (!slot.has_value()) {
+                slot.emplace(std::move(key), std::move(value));
+                hashes[i] = mixed;
+                ++count;
+                return;
+            }
+            if (hashes[i] == mixed && equal(slot->first, key)) {
+                slot->second = combine(std::move(slot->second), std::move(value));
+                return;
+            }
+        }
+    }
+
+    /**
+     * Folds every entry of other into this table, after the entries of this table.
+     */
+    template <typename BinaryFunction>
+    void merge(flat_table &&other, BinaryFunction &combine) {
+        other.consume([this, &combine](std::uint64_t mixed, entry &&e) {
+            accumulate(mixed, std::move(e.first), std::move(e.second), combine);
+        });
+    }
+
+    /**
+     * Feeds every entry, moved out of the table, into f: (uint64_t, entry&&) -> void, in no particular order.
+     */
+    template <typename BinaryFunction>
+    void consume(BinaryFunction f) {
+        for (std::size_t i = 0; i < slots.size(); ++i) {
+            if (slots[i].has_value()) {
+                f(hashes[i], std::move(*slots[i]));
+            }
+        }
+        slots.clear();
+        hashes.clear();
+        count = 0;
+    }
+
+  private:
+    void grow() {
+        auto previous = std::move(slots);
+        auto previous_hashes = std::move(hashes);
+        slots = std::vector<std::optional<entry>>(std::max<std::size_t>(previous.size() * 2, 16));
+        hashes = std::vector<std::uint64_t>(slots.size());
+        auto const mask = slots.size() - 1;
+        for (std::size_t j = 0; j < previous.size(); ++j) {
+            if (previous[j].has_value()) {
+                auto i = static_cast<std::size_t>(previous_hashes[j]) & mask;
+                while (slots[i].has_value()) {
+                    i = (i + 1) & mask;
+                }
+                slots[i] = std::move(previous[j]);
+                hashes[i] = previous_hashes[j];
+            }
+        }
+    }
+
+    std::vector<std::optional<entry>> slots;
+    std::vector<std::uint64_t> hashes;
+    std::size_t count{0};
+    KeyEqual equal;
+};
+
+/**
+ * The least number of values folded by each thread, below which input is folded on fewer threads, and a small enough
+ * input is folded on the calling thread only, as starting a thread costs more than folding that many values.
+ */
+inline constexpr std::size_t min_values_per_thread = 1024;
+
+/**
+ * Folds input into one table per partition of the key hash space, such that no two tables share a key.
+ *
+ * Each thread folds a contiguous range of input into its own tables, one per partition, and then each thread merges
+ * the tables of a single partition from every thread, in the order of their ranges. Hence, no table is ever shared
+ * between two running threads, and the values of each key are combined in the order of input.
+ */
+template <typename Input, typename KeyFunction, typename MapFunction, typename BinaryFunction, typename Hash,
+          typename KeyEqual>
+auto partitioned_fold(Input const &input, KeyFunction &key, MapFunction &map, BinaryFunction &combine,
+                      std::size_t threads) {
+    using A = typename Input::value_type;
+    using K = std::decay_t<std::invoke_result_t<KeyFunction &, A const &>>;
+    using V = std::decay_t<std::invoke_result_t<MapFunction &, A const &>>;
+    using table = flat_table<K, V, KeyEqual>;
+
+    auto const size = static_cast<std::size_t>(std::distance(std::cbegin(input), std::cend(input)));
+    threads = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(size / min_values_per_thread, 1));
+
+    auto bounds = std::vector<typename Input::const_iterator>{};
+    bounds.reserve(threads + 1);
+    auto it = std::cbegin(input);
+    for (std::size_t t = 0; t < threads; ++t) {
+        bounds.push_back(it);
+        std::advance(it, size / threads + (t < size % threads ? 1 : 0));
+    }
+    bounds.push_back(it);
+
+    auto partials = std::vector<std::vector<table>>(threads, std::vector<table>(threads));
+    concurrency::fork_join(threads, [&](std::size_t t) {
+        auto const hash = Hash{};
+        auto &local = partials[t];
+        for (auto e = bounds[t]; e != bounds[t + 1]; ++e) {
+            auto k = key(*e);
+            auto const mixed = mix(hash(k));
+            local[partition_of(mixed, threads)].accumulate(mixed, std::move(k), map(*e), combine);
+        }
+    });
+
+    auto partitions = std::vector<table>(threads);
+    concurrency::fork_join(threads, [&](std::size_t p) {
+        for (std::size_t t = 0; t < threads; ++t) {
+            partitions[p].merge(std::move(partials[t][p]), combine);
+        }
+    });
+    return partitions;
+}
+
+}
+
+/**
+ * Groups the values of input by key and folds the values of each group, in parallel: each value a: A is mapped into
+ * map(a): V and folded into the group of key(a): K via combine: (V, V) -> V.
+ *
+ * Every thread folds a contiguous range of input into its own open-addressing tables, which are then merged by
+ * partitioning the key hash space among the threads, so no lock is ever taken. Given that combine is associative, the
+ * result is the same as folding each group sequentially in the order of input. Each thread folds at least
+ * min_values_per_thread values, so a small input is folded on the calling thread only.
+ *
+ * @param input a sequence container of values of type A
+ * @param key a function A -> K, where K is hashable via Hash and comparable via KeyEqual, that's safe to call
+ * concurrently
+ * @param map a function A -> V that yields the value folded into a group, that's safe to call concurrently
+ * @param combine an associative function (V, V) -> V that's safe to call concurrently
+ * @param threads the maximum number of threads, by default the number of concurrent threads supported by the machine
+ * @return an unordered map from each distinct key to the fold of the values of its group
+ */
+template <typename Hash = void, typename KeyEqual = void, template <typename...> typename SequenceContainer,
+          typename A, typename KeyFunction, typename MapFunction, typename BinaryFunction,
+          typename = detail::enable_if_sequence_container<SequenceContainer>>
+auto group_fold(SequenceContainer<A> const &input, KeyFunction key, MapFunction map, BinaryFunction combine,
+                std::size_t threads = detail::concurrency::default_threads()) {
+    using K = std::decay_t<std::invoke_result_t<KeyFunction &, A const &>>;
+    using V = std::decay_t<std::invoke_result_t<MapFunction &, A const &>>;
+    using H = std::conditional_t<std::is_void_v<Hash>, std::hash<K>, Hash>;
+    using E = std::conditional_t<std::is_void_v<KeyEqual>, std::equal_to<K>, KeyEqual>;
+
+    auto partitions = detail::grouping::partitioned_fold<SequenceContainer<A>, KeyFunction, MapFunction,
+                                                         BinaryFunction, H, E>(input, key, map, combine, threads);
+    auto size = std::size_t{0};
+    for (auto const &partition : partitions) {
+        size += partition.size();
+    }
+    auto groups = std::unordered_map<K, V, H, E>{};
+    groups.reserve(size);
+    for (auto &partition : partitions) {
+        partition.consume([&groups](std::uint64_t, auto &&e) { groups.insert(std::move(e)); });
+    }
+    return groups;
+}
+
+/**
+ * Like group_fold, but returns the groups as a vector of pairs sorted by key via Compare, where the partitions are
+ * sorted in parallel and then merged.
+ *
+ * @param input a sequence container of values of type A
+ * @param key a function A -> K, where K is hashable via Hash and ordered via Compare, that's safe to call concurrently
+ * @param map a function A -> V that yields the value folded into a group, that's safe to call concurrently
+ * @param combine an associative function (V, V) -> V that's safe to call concurrently
+ * @param threads the maximum number of threads, by default the number of concurrent threads supported by the machine
+ * @return a vector of pairs of each distinct key and the fold of the values of its group, sorted by key
+ */
+template <typename Compare = std::less<>, typename Hash = void, template <typename...> typename SequenceContainer,
+          typename A, typename KeyFunction, typename MapFunction, typename BinaryFunction,
+          typename = detail::enable_if_sequence_container<SequenceContainer>>
+auto group_fold_sorted(SequenceContainer<A> const &input, KeyFunction key, MapFunction map, BinaryFunction combine,
+                       std::size_t threads = detail::concurrency::default_threads()) {
+    using K = std::decay_t<std::invoke_result_t<KeyFunction &, A const &>>;
+    using V = std::decay_t<std::invoke_result_t<MapFunction &, A const &>>;
+    using H = std::conditional_t<std::is_void_v<Hash>, std::hash<K>, Hash>;
+
+    auto partitions =
+        detail::grouping::partitioned_fold<SequenceContainer<A>, KeyFunction, MapFunction, BinaryFunction, H,
+                                           std::equal_to<K>>(input, key, map, combine, threads);
+    auto offsets = std::vector<std::size_t>{0};
+    for (auto const &partition : partitions) {
+        offsets.push_back(offsets.back() + partition.size());
+    }
+    auto groups = std::vector<std::pair<K, V>>{};
+    groups.reserve(offsets.back());
+    for (auto &partition : partitions) {
+        partition.consume([&groups](std::uint64_t, auto &&e) { groups.push_back(std::move(e)); });
+    }
+
+    auto const by_key = [compare = Compare{}](auto const &first, auto const &second) {
+        return compare(first.first, second.first);
+    };
+    detail::concurrency::fork_join(partitions.size(), [&](std::size_t p) {
+        std::sort(groups.begin() + offsets[p], groups.begin() + offsets[p + 1], by_key);
+    });
+    for (std::size_t width = 1; width < partitions.size(); width *= 2) {
+        auto const merges = (partitions.size() + 2 * width - 1) / (2 * width);
+        detail::concurrency::fork_join(merges, [&](std::size_t m) {
+            auto const first = m * 2 * width;
+            auto const middle = std::min(first + width, partitions.size());
+            auto const last = std::min(first + 2 * width, partitions.size());
+            std::inplace_merge(groups.begin() + offsets[first], groups.begin() + offsets[middle],
+                               groups.begin() + offsets[last], by_key);
+        });
+    }
+    return groups;
+}
+
+}
+
+#endif
@@ -0,0 +1,389 @@
+#ifndef RVARAGO_KITTEN_CHUNKED_VECTOR_H
+#define RVARAGO_KITTEN_CHUNKED_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "kitten/applicative.h"
+#include "kitten/functor.h"
+#include "kitten/monad.h"
+
+#include "kitten/detail/deriving/from_monad/derive_kleisli.h"
+
+namespace rvarago::kitten {
+
+namespace types {
+
+/**
+ * A sequence stored as a list of contiguous chunks, where elements pushed one at a time fill chunks of chunk_size,
+ * and each chunk is shared between every chunked_vector that links it.
+ *
+ * Appending another chunked_vector links its chunks that are at least half full rather than copying their elements,
+ * which makes concatenation O(chunks) instead of O(elements), whereas the elements of smaller chunks are copied into
+ * the last chunk, so that appending many short sequences still yields mostly full chunks. Chunks are copied-on-write,
+ * so a chunk is only ever modified while it's owned by a single chunked_vector.
+ */
+template <typename T>
+class chunked_vector {
+    using chunk_type = std::vector<T>;
+
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    static constexpr size_type chunk_size = std::max<size_type>(1, 4096 / sizeof(T));
+
+    class const_iterator {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T const *;
+        using reference = T const &;
+
+        const_iterator() = default;
+
+        reference operator*() const noexcept {
+            return (*(*current))[offset];
+        }
+
+        pointer operator->() const noexcept {
+            return &**this;
+        }
+
+        const_iterator &operator++() noexcept {
+            if (++offset == (*current)->size()) {
+                ++current;
+                offset = 0;
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) noexcept {
+            auto previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        friend bool operator==(const_iterator const &first, const_iterator const &second) noexcept {
+            return first.current == second.current && first.offset == second.offset;
+        }
+
+        friend bool operator!=(const_iterator const &first, const_iterator const &second) noexcept {
+            return !(first == second);
+        }
+
+      private:
+        friend class chunked_vector;
+
+        using chunk_iterator = typename std::vector<std::shared_ptr<chunk_type>>::const_iterator;
+
+        explicit const_iterator(chunk_iterator chunk) noexcept : current{chunk} {
+        }
+
+        chunk_iterator current{};
+        size_type offset{0};
+    };
+
+    using iterator = const_iterator;
+
+    chunked_vector() = default;
+
+    chunked_vector(chunked_vector const &) = default;
+
+    chunked_vector(chunked_vector &&other) noexcept
+        : chunks{std::move(other.chunks)}, count{std::exchange(other.count, 0)},
+          expected{std::exchange(other.expected, 0)} {
+        other.chunks.clear();
+    }
+
+    chunked_vector &operator=(chunked_vector const &) = default;
+
+    chunked_vector &operator=(chunked_vector &&other) noexcept {
+        if (this != &other) {
+            chunks = std::move(other.chunks);
+            other.chunks.clear();
+            count = std::exchange(other.count, 0);
+            expected = std::exchange(other.expected, 0);
+        }
+        return *this;
+    }
+
+    chunked_vector(std::initializer_list<T> values) {
+        reserve(values.size());
+        for (auto const &value : values) {
+            push_back(value);
+        }
+    }
+
+    explicit chunked_vector(std::vector<T> values) : count{values.size()} {
+        if (!values.empty()) {
+            chunks.push_back(std::make_shared<chunk_type>(std::move(values)));
+        }
+    }
+
+    size_type size() const noexcept {
+        return count;
+    }
+
+    bool empty() const noexcept {
+        return count == 0;
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator{chunks.cbegin()};
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator{chunks.cend()};
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    /**
+     * The number of chunks currently linked, none of them empty.
+     */
+    size_type chunk_count() const noexcept {
+        return chunks.size();
+    }
+
+    /**
+     * Announces that the size is about to grow up to capacity, so that the chunks created until then reserve room for
+     * the elements that they will actually hold rather than for a full chunk.
+     */
+    void reserve(size_type capacity) {
+        expected = std::max(expected, capacity);
+    }
+
+    /**
+     * Appends an element constructed in place from args to the last chunk, or to a new one if the last chunk is full
+     * or shared. The capacity of a chunk grows geometrically up to chunk_size, and a new chunk starts with room for
+     * the elements announced by reserve, if any, or else for as many elements as there already are, up to chunk_size.
+     */
+    template <typename... Args>
+    void emplace_back(Args &&... args) {
+        if (chunks.empty() || chunks.back()->size() >= chunk_size || chunks.back().use_count() > 1) {
+            auto chunk = std::make_shared<chunk_type>();
+            chunk->reserve(std::clamp<size_type>(expected > count ? expected - count : count, 1, chunk_size));
+            chunks.push_back(std::move(chunk));
+        } else if (auto &last = *chunks.back(); last.size() == last.capacity()) {
+            last.reserve(std::min(2 * last.capacity(), chunk_size));
+        }
+        chunks.back()->emplace_back(std::forward<Args>(args)...);
+        ++count;
+    }
+
+    void push_back(T const &value) {
+        emplace_back(value);
+    }
+
+    void push_back(T &&value) {
+        emplace_back(std::move(value));
+    }
+
+    /**
+     * Appends the elements of other at the end: its chunks that are at least half full are linked without copying any
+     * of their elements, and the elements of the others are copied into the last chunk.
+     */
+    void append(chunked_vector const &other) {
+        if (&other == this) {
+            append(chunked_vector{other});
+            return;
+        }
+        for (auto const &chunk : other.chunks) {
+            if (chunk->size() >= chunk_size / 2) {
+                chunks.push_back(chunk);
+                count += chunk->size();
+            } else {
+                for (auto const &e : *chunk) {
+                    emplace_back(e);
+                }
+            }
+        }
+    }
+
+    /**
+     * Like append(chunked_vector const &), but moves rather than copies the elements of the chunks of other that
+     * aren't shared with any other chunked_vector, and takes over the chunks of other altogether if this is empty.
+     */
+    void append(chunked_vector &&other) {
+        if (chunks.empty()) {
+            auto const hint = std::max(expected, other.expected);
+            *this = std::move(other);
+            expected = hint;
+            return;
+        }
+        for (auto &chunk : other.chunks) {
+            if (chunk->size() >= chunk_size / 2) {
+                count += chunk->size();
+                chunks.push_back(std::move(chunk));
+            } else if (chunk.use_count() == 1) {
+                for (auto &e : *chunk) {
+                    emplace_back(std::move(e));
+                }
+            } else {
+                for (auto const &e : *chunk) {
+                    emplace_back(e);
+                }
+            }
+        }
+        other.chunks.clear();
+        other.count = 0;
+        other.expected = 0;
+    }
+
+    /**
+     * Copies the elements into a single contiguous std::vector.
+     */
+    std::vector<T> flatten() const & {
+        auto flattened = std::vector<T>{};
+        flattened.reserve(count);
+        for (auto const &chunk : chunks) {
+            flattened.insert(flattened.end(), chunk->cbegin(), chunk->cend());
+        }
+        return flattened;
+    }
+
+    /**
+     * Moves the elements into a single contiguous std::vector, stealing the storage of a sole chunk and moving out of
+     * chunks that aren't shared with any other chunked_vector.
+     */
+    std::vector<T> flatten() && {
+        if (chunks.size() == 1 && chunks.front().use_count() == 1) {
+            auto flattened = std::move(*chunks.front());
+            chunks.clear();
+            count = 0;
+            return flattened;
+        }
+        auto flattened = std::vector<T>{};
+        flattened.reserve(count);
+        for (auto &chunk : chunks) {
+            if (chunk.use_count() == 1) {
+                std::move(chunk->begin(), chunk->end(), std::back_inserter(flattened));
+            } else {
+                flattened.insert(flattened.end(), chunk->cbegin(), chunk->cend());
+            }
+        }
+        chunks.clear();
+        count = 0;
+        return flattened;
+    }
+
+    friend bool operator==(chunked_vector const &first, chunked_vector const &second) {
+        return first.size() == second.size() && std::equal(first.cbegin(), first.cend(), second.cbegin());
+    }
+
+    friend bool operator!=(chunked_vector const &first, chunked_vector const &second) {
+        return !(first == second);
+    }
+
+  private:
+    std::vector<std::shared_ptr<chunk_type>> chunks;
+    size_type count{0};
+    size_type expected{0};
+};
+
+}
+
+template <>
+struct monad<types::chunked_vector> {
+
+    /**
+     * Appends every inner chunked_vector returned by f, linking its chunks that are at least half full and copying the
+     * elements of the others, so that the result is made of mostly full chunks however short the inner results are.
+     */
+    template <typename A, typename UnaryFunction>
+    static auto bind(types::chunked_vector<A> const &input, UnaryFunction f) -> decltype(f(std::declval<A>())) {
+        auto mapped_sequence = decltype(f(std::declval<A>())){};
+        for (auto const &e : input) {
+            mapped_sequence.append(f(e));
+        }
+        return mapped_sequence;
+    }
+
+    template <typename A>
+    static auto wrap(A &&value) -> types::chunked_vector<std::decay_t<A>> {
+        return wrap_in_place<std::decay_t<A>>(std::forward<A>(value));
+    }
+
+    template <typename A, typename... Args>
+    static auto wrap_in_place(Args &&... args) -> types::chunked_vector<A> {
+        auto singleton = types::chunked_vector<A>{};
+        singleton.emplace_back(std::forward<Args>(args)...);
+        return singleton;
+    }
+
+    template <typename UnaryFunctionA, typename UnaryFunctionB>
+    static auto compose(UnaryFunctionA f, UnaryFunctionB g) {
+        return detail::deriving::compose<types::chunked_vector>(std::move(f), std::move(g));
+    }
+};
+
+template <>
+struct applicative<types::chunked_vector> {
+
+    template <typename A, typename B, typename BinaryFunction>
+    static auto combine(types::chunked_vector<A> const &first, types::chunked_vector<B> const &second,
+                        BinaryFunction f) -> types::chunked_vector<decltype(f(std::declval<A>(), std::declval<B>()))> {
+        auto combined = types::chunked_vector<decltype(f(std::declval<A>(), std::declval<B>()))>{};
+        combined.reserve(first.size() * second.size());
+        for (auto const &first_value : first) {
+            for (auto const &second_value : second) {
+                combined.emplace_back(f(first_value, second_value));
+            }
+        }
+        return combined;
+    }
+
+    template <typename A>
+    static auto pure(A &&value) -> types::chunked_vector<std::decay_t<A>> {
+        return monad<types::chunked_vector>::wrap(std::forward<A>(value));
+    }
+
+    template <typename A, typename... Args>
+    static auto pure_in_place(Args &&... args) -> types::chunked_vector<A> {
+        return monad<types::chunked_vector>::wrap_in_place<A>(std::forward<Args>(args)...);
+    }
+};
+
+template <>
+struct functor<types::chunked_vector> {
+
+    template <typename A, typename UnaryFunction>
+    static auto fmap(types::chunked_vector<A> const &input, UnaryFunction f)
+        -> types::chunked_vector<decltype(f(std::declval<A>()))> {
+        auto mapped = types::chunked_vector<decltype(f(std::declval<A>()))>{};
+        mapped.reserve(input.size());
+        for (auto const &e : input) {
+            mapped.emplace_back(f(e));
+        }
+        return mapped;
+    }
+};
+
+namespace traits {
+template <>
+struct is_monad<types::chunked_vector> : std::true_type {};
+
+template <>
+struct is_applicative<types::chunked_vector> : std::true_type {};
+
+template <>
+struct is_functor<types::chunked_vector> : std::true_type {};
+}
+
+}
+
+#endif
@@ -0,0 +1,423 @@
+#ifndef RVARAGO_KITTEN_COLUMNS_H
+#define RVARAGO_KITTEN_COLUMNS_H
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "kitten/applicative.h"
+#include "kitten/functor.h"
+#include "kitten/multifunctor.h"
+
+namespace rvarago::kitten {
+
+namespace types {
+
+/**
+ * A sequence of rows of type std::tuple<Ts...> laid out as a struct-of-arrays: one vector per column, so that a
+ * column can be traversed without dragging the other columns through the cache.
+ *
+ * Columns are shared between copies, and are only copied once modified while shared, so mapping a single column via
+ * multimap_column leaves the other columns shared with the input.
+ */
+template <typename... Ts>
+class columns {
+    static_assert(sizeof...(Ts) > 0, "columns must have at least one column");
+
+  public:
+    using value_type = std::tuple<Ts...>;
+    using row_view = std::tuple<Ts const &...>;
+    using size_type = std::size_t;
+
+    class const_iterator {
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::tuple<Ts...>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = row_view;
+
+        const_iterator() = default;
+
+        reference operator*() const {
+            return table->row(index);
+        }
+
+        const_iterator &operator++() noexcept {
+            ++index;
+            return *this;
+        }
+
+        const_iterator operator++(int) noexcept {
+            auto previous = *this;
+            ++index;
+            return previous;
+        }
+
+        friend bool operator==(const_iterator const &first, const_iterator const &second) noexcept {
+            return first.table == second.table && first.index == second.index;
+        }
+
+        friend bool operator!=(const_iterator const &first, const_iterator const &second) noexcept {
+            return !(first == second);
+        }
+
+      private:
+        friend class columns;
+
+        const_iterator(columns const *owner, size_type position) noexcept : table{owner}, index{position} {
+        }
+
+        columns const *table{nullptr};
+        size_type index{0};
+    };
+
+    using iterator = const_iterator;
+
+    columns() : data{std::make_shared<std::vector<Ts>>()...} {
+    }
+
+    /**
+     * Takes one vector per column, which must all have the same size.
+     */
+    explicit columns(std::vector<Ts>... values) : data{std::make_shared<std::vector<Ts>>(std::move(values))...} {
+        if (!have_same_size(std::index_sequence_for<Ts...>{})) {
+            throw std::invalid_argument{"columns must have the same size"};
+        }
+    }
+
+    explicit columns(std::vector<value_type> const &rows) : columns{} {
+        reserve(rows.size());
+        for (auto const &row : rows) {
+            push_back(row);
+        }
+    }
+
+    size_type size() const noexcept {
+        return std::get<0>(data)->size();
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    template <std::size_t I>
+    auto const &column() const noexcept {
+        return *std::get<I>(data);
+    }
+
+    /**
+     * @return the i-th row as a tuple of references into the columns, without copying any value
+     */
+    row_view row(size_type i) const {
+        return row(i, std::index_sequence_for<Ts...>{});
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator{this, 0};
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator{this, size()};
+    }
+
+    void reserve(size_type capacity) {
+        for_each_column([capacity](auto &column) { column.reserve(capacity); });
+    }
+
+    void push_back(value_type const &row) {
+        push_back(row, std::index_sequence_for<Ts...>{});
+    }
+
+    /**
+     * Appends a row whose I-th value is constructed in place from the I-th tuple of arguments.
+     */
+    template <typename... Arguments>
+    void emplace_back(std::piecewise_construct_t, Arguments &&... arguments) {
+        static_assert(sizeof...(Arguments) == sizeof...(Ts), "emplace_back takes a tuple of arguments per column");
+        emplace_back(std::index_sequence_for<Ts...>{}, std::forward<Arguments>(arguments)...);
+    }
+
+    /**
+     * Maps the I-th column via f, and shares every other column with the result rather than copying it.
+     */
+    template <std::size_t I, typename UnaryFunction>
+    auto map_column(UnaryFunction f) const {
+        return map_column<I>(f, std::index_sequence_for<Ts...>{});
+    }
+
+    /**
+     * Copies the rows into a vector of tuples.
+     */
+    std::vector<value_type> to_rows() const {
+        return std::vector<value_type>(begin(), end());
+    }
+
+    friend bool operator==(columns const &first, columns const &second) {
+        return first.data == second.data || first.equal(second, std::index_sequence_for<Ts...>{});
+    }
+
+    friend bool operator!=(columns const &first, columns const &second) {
+        return !(first == second);
+    }
+
+  private:
+    template <typename... Us>
+    friend class columns;
+
+    explicit columns(std::tuple<std::shared_ptr<std::vector<Ts>>...> shared) : data{std::move(shared)} {
+    }
+
+    template <std::size_t I, typename UnaryFunction, std::size_t... Indices>
+    auto map_column(UnaryFunction &f, std::index_sequence<Indices...>) const {
+        using mapped_column = std::vector<decltype(f(std::declval<std::tuple_element_t<I, value_type>>()))>;
+        auto mapped = std::make_shared<mapped_column>();
+        mapped->reserve(size());
+        for (auto const &value : *std::get<I>(data)) {
+            mapped->push_back(f(value));
+        }
+        auto select = [&mapped](auto index, auto const &column) {
+            if constexpr (decltype(index)::value == I) {
+                return mapped;
+            } else {
+                return column;
+            }
+        };
+        auto shared = std::tuple{select(std::integral_constant<std::size_t, Indices>{}, std::get<Indices>(data))...};
+        return columns<typename std::tuple_element_t<Indices, decltype(shared)>::element_type::value_type...>{
+            std::move(shared)};
+    }
+
+    template <std::size_t... Indices>
+    row_view row(size_type i, std::index_sequence<Indices...>) const {
+        return row_view{(*std::get<Indices>(data))[i]...};
+    }
+
+    template <std::size_t... Indices>
+    void push_back(value_type const &row, std::index_sequence<Indices...>) {
+        (editable<Indices>().push_back(std::get<Indices>(row)), ...);
+    }
+
+    template <std::size_t... Indices, typename... Arguments>
+    void emplace_back(std::index_sequence<Indices...>, Arguments &&... arguments) {
+        (std::apply(
+             [&column = editable<Indices>()](auto &&... args) {
+                 column.emplace_back(std::forward<decltype(args)>(args)...);
+             },
+             std::forward<Arguments>(arguments)),
+         ...);
+    }
+
+    template <std::size_t... Indices>
+    bool have_same_size(std::index_sequence<Indices...>) const noexcept {
+        return ((std::get<Indices>(data)->size() == size()) && ...);
+    }
+
+    template <std::size_t... Indices>
+    bool equal(columns const &other, std::index_sequence<Indices...>) const {
+        return ((*std::get<Indices>(data) == *std::get<Indices>(other.data)) && ...);
+    }
+
+    template <typename ColumnFunction>
+    void for_each_column(ColumnFunction f) {
+        std::apply([&f](auto &... column) { (f(editable_column(column)), ...); }, data);
+    }
+
+    template <std::size_t I>
+    auto &editable() {
+        return editable_column(std::get<I>(data));
+    }
+
+    /**
+     * Copies the column before it's modified, if it's shared with other columns.
+     */
+    template <typename T>
+    static std::vector<T> &editable_column(std::shared_ptr<std::vector<T>> &column) {
+        if (column.use_count() > 1) {
+            column = std::make_shared<std::vector<T>>(*column);
+        }
+        return *column;
+    }
+
+    std::tuple<std::shared_ptr<std::vector<Ts>>...> data;
+};
+
+}
+
+namespace detail::columnar {
+
+template <typename>
+using no_arguments = std::tuple<>;
+
+template <typename R>
+struct columns_of {
+    using type = types::columns<R>;
+
+    static std::tuple<R> as_row(R value) {
+        return std::tuple<R>{std::move(value)};
+    }
+
+    template <typename... Args>
+    static void emplace(type &columns, Args &&... args) {
+        columns.emplace_back(std::piecewise_construct, std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+};
+
+/**
+ * Functions that return tuples produce one column per element of the tuple, holding its decayed type, such that rows
+ * of references, e.g. the row_view passed to f, are copied into the output.
+ */
+template <typename... Us>
+struct columns_of<std::tuple<Us...>> {
+    using type = types::columns<std::decay_t<Us>...>;
+
+    static std::tuple<std::decay_t<Us>...> as_row(std::tuple<Us...> value) {
+        return std::tuple<std::decay_t<Us>...>{std::move(value)};
+    }
+
+    /**
+     * Constructs each value of the row in place, as std::tuple<Us...> would: from its own argument, by default when
+     * there are no arguments, or from its element of a single tuple-like argument.
+     */
+    template <typename... Args>
+    static void emplace(type &columns, Args &&... args) {
+        if constexpr (sizeof...(Args) == sizeof...(Us)) {
+            columns.emplace_back(std::piecewise_construct, std::forward_as_tuple(std::forward<Args>(args))...);
+        } else if constexpr (sizeof...(Args) == 0) {
+            columns.emplace_back(std::piecewise_construct, no_arguments<Us>{}...);
+        } else {
+            emplace_elements(columns, std::index_sequence_for<Us...>{}, std::forward<Args>(args)...);
+        }
+    }
+
+  private:
+    template <std::size_t... Indices, typename Tuple>
+    static void emplace_elements(type &columns, std::index_sequence<Indices...>, Tuple &&row) {
+        columns.emplace_back(std::piecewise_construct,
+                             std::forward_as_tuple(std::get<Indices>(std::forward<Tuple>(row)))...);
+    }
+};
+
+template <typename R>
+using columns_of_t = typename columns_of<R>::type;
+
+}
+
+/**
+ * Maps the I-th column of input via f, and shares every other column with input rather than copying it.
+ *
+ * @param input columns whose I-th column holds values of type A
+ * @param f a function A -> B
+ * @return new columns whose I-th column holds the mapped values of type B, and whose other columns are the ones of
+ * input
+ */
+template <std::size_t I, typename UnaryFunction, typename... Ts>
+auto multimap_column(types::columns<Ts...> const &input, UnaryFunction f) {
+    return input.template map_column<I>(f);
+}
+
+/**
+ * The multifunctor instance maps every column at once, each one through the overload of f for its type, e.g. via
+ * syntax::overloaded.
+ */
+template <>
+struct multifunctor<types::columns> {
+
+    template <typename UnaryFunction, typename... Ts>
+    static auto multimap(types::columns<Ts...> const &input, UnaryFunction f)
+        -> types::columns<decltype(f(std::declval<Ts>()))...> {
+        return multimap(input, f, std::index_sequence_for<Ts...>{});
+    }
+
+  private:
+    template <typename UnaryFunction, typename... Ts, std::size_t... Indices>
+    static auto multimap(types::columns<Ts...> const &input, UnaryFunction &f, std::index_sequence<Indices...>)
+        -> types::columns<decltype(f(std::declval<Ts>()))...> {
+        auto map_column = [&f](auto const &column) {
+            auto mapped = std::vector<decltype(f(column.front()))>{};
+            mapped.reserve(column.size());
+            for (auto const &value : column) {
+                mapped.push_back(f(value));
+            }
+            return mapped;
+        };
+        return types::columns<decltype(f(std::declval<Ts>()))...>{map_column(input.template column<Indices>())...};
+    }
+};
+
+/**
+ * The functor and applicative instances see rows: f receives each row as a tuple of references, and returns either a
+ * tuple, which becomes a row of the output, or a single value, which becomes a row of a single column.
+ */
+template <>
+struct functor<types::columns> {
+
+    template <typename UnaryFunction, typename... Ts>
+    static auto fmap(types::columns<Ts...> const &input, UnaryFunction f)
+        -> detail::columnar::columns_of_t<decltype(f(std::declval<typename types::columns<Ts...>::row_view>()))> {
+        using R = decltype(f(std::declval<typename types::columns<Ts...>::row_view>()));
+        auto mapped = detail::columnar::columns_of_t<R>{};
+        mapped.reserve(input.size());
+        for (auto const &row : input) {
+            mapped.push_back(detail::columnar::columns_of<R>::as_row(f(row)));
+        }
+        return mapped;
+    }
+};
+
+template <>
+struct applicative<types::columns> {
+
+    /**
+     * Combines every row of first with every row of second, as the sequence containers do.
+     */
+    template <typename BinaryFunction, typename... Ts, typename... Us>
+    static auto combine(types::columns<Ts...> const &first, types::columns<Us...> const &second, BinaryFunction f)
+        -> detail::columnar::columns_of_t<decltype(f(std::declval<typename types::columns<Ts...>::row_view>(),
+                                                     std::declval<typename types::columns<Us...>::row_view>()))> {
+        using R = decltype(f(std::declval<typename types::columns<Ts...>::row_view>(),
+                             std::declval<typename types::columns<Us...>::row_view>()));
+        auto combined = detail::columnar::columns_of_t<R>{};
+        combined.reserve(first.size() * second.size());
+        for (auto const &first_row : first) {
+            for (auto const &second_row : second) {
+                combined.push_back(detail::columnar::columns_of<R>::as_row(f(first_row, second_row)));
+            }
+        }
+        return combined;
+    }
+
+    template <typename A>
+    static auto pure(A &&value) -> detail::columnar::columns_of_t<std::decay_t<A>> {
+        auto singleton = detail::columnar::columns_of_t<std::decay_t<A>>{};
+        singleton.push_back(detail::columnar::columns_of<std::decay_t<A>>::as_row(std::forward<A>(value)));
+        return singleton;
+    }
+
+    template <typename A, typename... Args>
+    static auto pure_in_place(Args &&... args) -> detail::columnar::columns_of_t<A> {
+        auto singleton = detail::columnar::columns_of_t<A>{};
+        detail::columnar::columns_of<A>::emplace(singleton, std::forward<Args>(args)...);
+        return singleton;
+    }
+};
+
+namespace traits {
+template <>
+struct is_multifunctor<types::columns> : std::true_type {};
+
+template <>
+struct is_functor<types::columns> : std::true_type {};
+
+template <>
+struct is_applicative<types::columns> : std::true_type {};
+}
+
+}
+
+#endif
@@ -0,0 +1,344 @@
+#ifndef RVARAGO_KITTEN_COMPACT_OPTIONAL_H
+#define RVARAGO_KITTEN_COMPACT_OPTIONAL_H
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "kitten/applicative.h"
+#include "kitten/functor.h"
+#include "kitten/monad.h"
+
+#include "kitten/detail/deriving/from_monad/derive_applicative.h"
+
+namespace rvarago::kitten {
+
+namespace types {
+
+/**
+ * A policy of compact_optional that encodes emptiness as Value, e.g. -1 for an index, or an enumerator.
+ */
+template <auto Value>
+struct value_sentinel {
+    using value_type = decltype(Value);
+
+    static constexpr value_type empty_value() noexcept {
+        return Value;
+    }
+
+    static constexpr bool is_empty(value_type const &value) noexcept {
+        return value == Value;
+    }
+};
+
+/**
+ * A policy of compact_optional that encodes emptiness as the lowest value of a signed integral type, e.g. INT_MIN.
+ */
+template <typename T>
+struct min_sentinel {
+    static_assert(std::is_integral_v<T>, "min_sentinel requires an integral type");
+
+    static constexpr T empty_value() noexcept {
+        return std::numeric_limits<T>::min();
+    }
+
+    static constexpr bool is_empty(T const &value) noexcept {
+        return value == std::numeric_limits<T>::min();
+    }
+};
+
+/**
+ * A policy of compact_optional that encodes emptiness as the highest value of an unsigned integral type, e.g. SIZE_MAX,
+ * which leaves 0 representable.
+ */
+template <typename T>
+struct max_sentinel {
+    static_assert(std::is_integral_v<T>, "max_sentinel requires an integral type");
+
+    static constexpr T empty_value() noexcept {
+        return std::numeric_limits<T>::max();
+    }
+
+    static constexpr bool is_empty(T const &value) noexcept {
+        return value == std::numeric_limits<T>::max();
+    }
+};
+
+/**
+ * A policy of compact_optional that encodes emptiness as a quiet NaN with a dedicated payload, so that every other
+ * value, including the NaNs produced by arithmetic, remains representable.
+ */
+template <typename T>
+struct nan_sentinel {
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "nan_sentinel requires float or double");
+
+    using bits_type = std::conditional_t<sizeof(T) == sizeof(std::uint32_t), std::uint32_t, std::uint64_t>;
+
+    static constexpr bits_type empty_bits =
+        static_cast<bits_type>(sizeof(T) == sizeof(std::uint32_t) ? 0x7FC0'5E77ull : 0x7FF8'0000'0000'5E77ull);
+
+    static T empty_value() noexcept {
+        auto value = T{};
+        std::memcpy(&value, &empty_bits, sizeof(T));
+        return value;
+    }
+
+    static bool is_empty(T const &value) noexcept {
+        auto bits = bits_type{};
+        std::memcpy(&bits, &value, sizeof(T));
+        return bits == empty_bits;
+    }
+};
+
+/**
+ * A policy of compact_optional that encodes emptiness as a null pointer.
+ */
+template <typename T>
+struct null_sentinel {
+    static_assert(std::is_pointer_v<T>, "null_sentinel requires a pointer type");
+
+    static constexpr T empty_value() noexcept {
+        return nullptr;
+    }
+
+    static constexpr bool is_empty(T const &value) noexcept {
+        return value == nullptr;
+    }
+};
+
+template <typename T, typename = void>
+struct default_sentinel {
+    static_assert(!std::is_same_v<T, T>, "type T has no default sentinel, so compact_optional requires a policy");
+};
+
+template <typename T>
+struct default_sentinel<T, std::enable_if_t<std::is_integral_v<T> && std::is_signed_v<T>>> {
+    using type = min_sentinel<T>;
+};
+
+template <typename T>
+struct default_sentinel<T, std::enable_if_t<std::is_unsigned_v<T> && !std::is_same_v<T, bool>>> {
+    using type = max_sentinel<T>;
+};
+
+template <typename T>
+struct default_sentinel<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+    using type = nan_sentinel<T>;
+};
+
+template <typename T>
+struct default_sentinel<T, std::enable_if_t<std::is_pointer_v<T>>> {
+    using type = null_sentinel<T>;
+};
+
+template <typename T>
+using default_sentinel_t = typename default_sentinel<T>::type;
+
+/**
+ * An optional value of type T that takes no more space than T itself, by encoding emptiness as a sentinel value of T
+ * that's defined by Policy, which provides static empty_value() and is_empty(value). By default, it's the lowest value
+ * of signed integral types, the highest value of unsigned ones, a dedicated NaN of floating-point types, and nullptr of
+ * pointers.
+ *
+ * The sentinel itself is never a value, so constructing a compact_optional from it throws rather than yielding an
+ * empty one. It's trivially copyable whenever T is, and its functor, applicative, and monad instances behave as the
+ * ones of std::optional.
+ */
+template <typename T, typename Policy = default_sentinel_t<T>>
+class compact_optional {
+  public:
+    using value_type = T;
+    using policy_type = Policy;
+
+    constexpr compact_optional() noexcept(std::is_nothrow_copy_constructible_v<T>) : stored{Policy::empty_value()} {
+    }
+
+    constexpr compact_optional(std::nullopt_t) noexcept(std::is_nothrow_copy_constructible_v<T>)
+        : compact_optional{} {
+    }
+
+    /**
+     * @throws std::invalid_argument if value is the sentinel
+     */
+    constexpr compact_optional(T value) : stored{std::move(value)} {
+        reject_sentinel();
+    }
+
+    /**
+     * Constructs the value in place from args.
+     *
+     * @throws std::invalid_argument if the value is the sentinel
+     */
+    template <typename... Args>
+    constexpr explicit compact_optional(std::in_place_t, Args &&... args) : stored(std::forward<Args>(args)...) {
+        reject_sentinel();
+    }
+
+    constexpr bool has_value() const noexcept {
+        return !Policy::is_empty(stored);
+    }
+
+    constexpr explicit operator bool() const noexcept {
+        return has_value();
+    }
+
+    constexpr T const &operator*() const noexcept {
+        return stored;
+    }
+
+    constexpr T const *operator->() const noexcept {
+        return &stored;
+    }
+
+    /**
+     * @throws std::bad_optional_access if empty
+     */
+    constexpr T const &value() const {
+        if (!has_value()) {
+            throw std::bad_optional_access{};
+        }
+        return stored;
+    }
+
+    template <typename U>
+    constexpr T value_or(U &&fallback) const {
+        return has_value() ? stored : static_cast<T>(std::forward<U>(fallback));
+    }
+
+    constexpr void reset() noexcept(std::is_nothrow_copy_assignable_v<T>) {
+        stored = Policy::empty_value();
+    }
+
+    /**
+     * @return the optional value as an std::optional
+     */
+    constexpr std::optional<T> to_optional() const {
+        return has_value() ? std::optional<T>{stored} : std::nullopt;
+    }
+
+    friend constexpr bool operator==(compact_optional const &first, compact_optional const &second) {
+        return first.has_value() == second.has_value() && (!first.has_value() || *first == *second);
+    }
+
+    friend constexpr bool operator!=(compact_optional const &first, compact_optional const &second) {
+        return !(first == second);
+    }
+
+    friend constexpr bool operator==(compact_optional const &input, std::nullopt_t) noexcept {
+        return !input.has_value();
+    }
+
+    friend constexpr bool operator!=(compact_optional const &input, std::nullopt_t) noexcept {
+        return input.has_value();
+    }
+
+  private:
+    constexpr void reject_sentinel() const {
+        if (Policy::is_empty(stored)) {
+            throw std::invalid_argument{"compact_optional can't hold its sentinel as a value"};
+        }
+    }
+
+    T stored;
+};
+
+}
+
+/**
+ * The instances behave as the ones of std::optional, and the compact_optionals that they create use the default
+ * sentinel of their value type, which must therefore be an integral, floating-point, or pointer type: e.g. mapping into
+ * an std::string fails to compile, so map into an std::optional instead.
+ *
+ * Unlike std::optional, wrapping, mapping, or combining into the sentinel throws std::invalid_argument, since the
+ * sentinel can't be held as a value.
+ */
+template <>
+struct monad<types::compact_optional> {
+
+    template <typename A, typename Policy, typename UnaryFunction>
+    static constexpr auto bind(types::compact_optional<A, Policy> const &input, UnaryFunction f)
+        -> decltype(f(std::declval<A>())) {
+        if (!input.has_value()) {
+            return std::nullopt;
+        }
+        return f(*input);
+    }
+
+    template <typename A>
+    static constexpr auto wrap(A &&value) -> types::compact_optional<std::decay_t<A>> {
+        return wrap_in_place<std::decay_t<A>>(std::forward<A>(value));
+    }
+
+    template <typename A, typename... Args>
+    static constexpr auto wrap_in_place(Args &&... args) -> types::compact_optional<A> {
+        return types::compact_optional<A>{std::in_place, std::forward<Args>(args)...};
+    }
+
+    template <typename UnaryFunctionA, typename UnaryFunctionB>
+    static constexpr auto compose(UnaryFunctionA f, UnaryFunctionB g) {
+        return [f = std::move(f), g = std::move(g)](auto &&value)
+                   -> decltype(g(*f(std::forward<decltype(value)>(value)))) {
+            auto const intermediate = f(std::forward<decltype(value)>(value));
+            if (!intermediate.has_value()) {
+                return std::nullopt;
+            }
+            return g(*intermediate);
+        };
+    }
+};
+
+template <>
+struct applicative<types::compact_optional> {
+
+    template <typename A, typename PolicyA, typename B, typename PolicyB, typename BinaryFunction>
+    static constexpr auto combine(types::compact_optional<A, PolicyA> const &first,
+                                  types::compact_optional<B, PolicyB> const &second, BinaryFunction f)
+        -> types::compact_optional<decltype(f(std::declval<A>(), std::declval<B>()))> {
+        if (!first.has_value() || !second.has_value()) {
+            return std::nullopt;
+        }
+        return f(*first, *second);
+    }
+
+    template <typename A>
+    static constexpr auto pure(A &&value) -> types::compact_optional<std::decay_t<A>> {
+        return detail::deriving::pure<types::compact_optional>(std::forward<A>(value));
+    }
+
+    template <typename A, typename... Args>
+    static constexpr auto pure_in_place(Args &&... args) -> types::compact_optional<A> {
+        return detail::deriving::pure_in_place<types::compact_optional, A>(std::forward<Args>(args)...);
+    }
+};
+
+template <>
+struct functor<types::compact_optional> {
+
+    template <typename A, typename Policy, typename UnaryFunction>
+    static constexpr auto fmap(types::compact_optional<A, Policy> const &input, UnaryFunction f)
+        -> types::compact_optional<decltype(f(std::declval<A>()))> {
+        if (!input.has_value()) {
+            return std::nullopt;
+        }
+        return f(*input);
+    }
+};
+
+namespace traits {
+template <>
+struct is_monad<types::compact_optional> : std::true_type {};
+
+template <>
+struct is_applicative<types::compact_optional> : std::true_type {};
+
+template <>
+struct is_functor<types::compact_optional> : std::true_type {};
+}
+
+}
+
+#endif
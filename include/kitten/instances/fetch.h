@@ -0,0 +1,376 @@
+#ifndef RVARAGO_KITTEN_FETCH_H
+#define RVARAGO_KITTEN_FETCH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "kitten/applicative.h"
+#include "kitten/functor.h"
+#include "kitten/monad.h"
+
+#include "kitten/detail/deriving/from_monad/derive_kleisli.h"
+
+namespace rvarago::kitten {
+
+namespace detail::fetching {
+
+/**
+ * A data source whose pending lookups are fetched in a single batch once a round is over.
+ */
+class source {
+  public:
+    virtual ~source() = default;
+
+    virtual void flush() = 0;
+};
+
+template <typename T>
+struct progress;
+
+/**
+ * Runs a fetch as far as possible with the values fetched so far.
+ */
+template <typename T>
+using step = std::function<progress<T>()>;
+
+/**
+ * Either the value of a fetch, or the sources that it's blocked on and the step that resumes it once they are flushed.
+ */
+template <typename T>
+struct progress {
+    std::optional<T> value;
+    std::vector<std::shared_ptr<source>> blocked_on;
+    step<T> rest;
+};
+
+template <typename T>
+progress<T> done(T value) {
+    return {std::optional<T>{std::move(value)}, {}, {}};
+}
+
+template <typename T>
+progress<T> blocked(std::vector<std::shared_ptr<source>> sources, step<T> rest) {
+    return {std::nullopt, std::move(sources), std::move(rest)};
+}
+
+template <typename T>
+step<T> pure(T value) {
+    return [value = std::move(value)] { return done(value); };
+}
+
+template <typename A, typename UnaryFunction, typename B = std::decay_t<std::invoke_result_t<UnaryFunction &, A &>>>
+step<B> fmap(step<A> input, UnaryFunction f) {
+    return [input = std::move(input), f = std::move(f)]() mutable -> progress<B> {
+        auto p = input();
+        if (p.value.has_value()) {
+            return done<B>(f(*p.value));
+        }
+        return blocked<B>(std::move(p.blocked_on), fmap(std::move(p.rest), f));
+    };
+}
+
+/**
+ * Runs both steps in the same round, so that the lookups they are blocked on are batched together.
+ */
+template <typename A, typename B, typename BinaryFunction,
+          typename C = std::decay_t<std::invoke_result_t<BinaryFunction &, A &, B &>>>
+step<C> combine(step<A> first, step<B> second, BinaryFunction f) {
+    return [first = std::move(first), second = std::move(second), f = std::move(f)]() mutable -> progress<C> {
+        auto p = first();
+        auto q = second();
+        if (p.value.has_value() && q.value.has_value()) {
+            return done<C>(f(*p.value, *q.value));
+        }
+        auto sources = std::move(p.blocked_on);
+        sources.insert(sources.end(), q.blocked_on.begin(), q.blocked_on.end());
+        auto rest_first = p.value.has_value() ? pure(std::move(*p.value)) : std::move(p.rest);
+        auto rest_second = q.value.has_value() ? pure(std::move(*q.value)) : std::move(q.rest);
+        return blocked<C>(std::move(sources), combine(std::move(rest_first), std::move(rest_second), f));
+    };
+}
+
+/**
+ * Runs every pending step of a collection in the same round, as combine does, and stores each value at the index of
+ * its step. The steps that are still blocked are kept in a flat vector, rather than nested in a combine per step, so
+ * a round takes time and stack space linear in the number of steps.
+ */
+template <typename T>
+step<std::vector<T>> all(std::vector<std::optional<T>> values, std::vector<std::pair<std::size_t, step<T>>> pending) {
+    return [values = std::move(values), pending = std::move(pending)]() -> progress<std::vector<T>> {
+        auto fetched = values;
+        auto sources = std::vector<std::shared_ptr<source>>{};
+        auto still_pending = std::vector<std::pair<std::size_t, step<T>>>{};
+        for (auto const &[i, s] : pending) {
+            auto p = s();
+            if (p.value.has_value()) {
+                fetched[i] = std::move(p.value);
+            } else {
+                sources.insert(sources.end(), p.blocked_on.begin(), p.blocked_on.end());
+                still_pending.emplace_back(i, std::move(p.rest));
+            }
+        }
+        if (!still_pending.empty()) {
+            return blocked<std::vector<T>>(std::move(sources), all(std::move(fetched), std::move(still_pending)));
+        }
+        auto collected = std::vector<T>{};
+        collected.reserve(fetched.size());
+        for (auto &value : fetched) {
+            collected.push_back(std::move(*value));
+        }
+        return done(std::move(collected));
+    };
+}
+
+template <typename T>
+T run(step<T> current) {
+    for (;;) {
+        auto p = current();
+        if (p.value.has_value()) {
+            return std::move(*p.value);
+        }
+        std::sort(p.blocked_on.begin(), p.blocked_on.end());
+        p.blocked_on.erase(std::unique(p.blocked_on.begin(), p.blocked_on.end()), p.blocked_on.end());
+        for (auto const &s : p.blocked_on) {
+            s->flush();
+        }
+        current = std::move(p.rest);
+    }
+}
+
+}
+
+namespace types {
+
+/**
+ * A computation that yields a value of type T from lookups into data sources, which runs in rounds: every lookup
+ * that's independent of the others is collected during a round, and then every data source is called once with all of
+ * its lookups of the round.
+ *
+ * combine runs both of its sides in the same round, whereas bind starts a new round whenever the function depends on
+ * a value that's yet to be fetched. Hence, the number of round trips to a data source is the depth of the dependencies
+ * between its lookups, rather than the number of lookups.
+ *
+ * A fetch runs on the calling thread, and isn't safe to run concurrently with another fetch of the same data source.
+ */
+template <typename T>
+class fetch {
+  public:
+    using value_type = T;
+
+    explicit fetch(detail::fetching::step<T> steps) : next{std::move(steps)} {
+    }
+
+    /**
+     * Runs every round until the value is available, calling each data source once per round it's blocked on.
+     */
+    T run() const {
+        return detail::fetching::run(next);
+    }
+
+    detail::fetching::step<T> const &steps() const noexcept {
+        return next;
+    }
+
+  private:
+    detail::fetching::step<T> next;
+};
+
+/**
+ * A source of values of type V by keys of type K, which fetches many keys at once via a user-supplied batch function
+ * std::vector<K> -> std::vector<V>, returning a value per key in the same order.
+ *
+ * The keys requested during a round are deduplicated, and every fetched value is cached for the lifetime of the data
+ * source, so that a key is fetched once. Copies of a data source share their cache.
+ */
+template <typename K, typename V, typename Hash = std::hash<K>>
+class data_source {
+    struct state final : detail::fetching::source {
+        std::function<std::vector<V>(std::vector<K> const &)> batch;
+        std::unordered_map<K, V, Hash> cache;
+        std::vector<K> pending;
+        std::unordered_set<K, Hash> requested;
+        std::size_t round_trips{0};
+
+        template <typename BatchFunction>
+        explicit state(BatchFunction f) : batch{std::move(f)} {
+        }
+
+        void request(K const &key) {
+            if (requested.insert(key).second) {
+                pending.push_back(key);
+            }
+        }
+
+        void flush() override {
+            if (pending.empty()) {
+                return;
+            }
+            auto keys = std::move(pending);
+            pending.clear();
+            requested.clear();
+            auto values = batch(keys);
+            ++round_trips;
+            if (values.size() != keys.size()) {
+                throw std::invalid_argument{"data source must return a value per key"};
+            }
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                cache.insert_or_assign(std::move(keys[i]), std::move(values[i]));
+            }
+        }
+    };
+
+  public:
+    template <typename BatchFunction>
+    explicit data_source(BatchFunction batch) : shared{std::make_shared<state>(std::move(batch))} {
+    }
+
+    /**
+     * @return a fetch of the value of key, which is cached or else blocked until the end of the round
+     */
+    fetch<V> get(K key) const {
+        return fetch<V>{lookup(shared, std::move(key))};
+    }
+
+    /**
+     * @return the number of calls made to the batch function so far
+     */
+    std::size_t round_trips() const noexcept {
+        return shared->round_trips;
+    }
+
+    void clear_cache() {
+        shared->cache.clear();
+    }
+
+  private:
+    static detail::fetching::step<V> lookup(std::shared_ptr<state> const &source, K key) {
+        return [source, key = std::move(key)]() -> detail::fetching::progress<V> {
+            if (auto const cached = source->cache.find(key); cached != source->cache.end()) {
+                return detail::fetching::done(cached->second);
+            }
+            source->request(key);
+            return detail::fetching::blocked<V>({source}, lookup(source, key));
+        };
+    }
+
+    std::shared_ptr<state> shared;
+};
+
+/**
+ * Runs every fetch in the same round, as combine does, and collects their values in order.
+ *
+ * @param fetches the fetches of values of type T
+ * @return a fetch of the vector of the values of fetches
+ */
+template <typename T>
+fetch<std::vector<T>> fetch_all(std::vector<fetch<T>> const &fetches) {
+    auto pending = std::vector<std::pair<std::size_t, detail::fetching::step<T>>>{};
+    pending.reserve(fetches.size());
+    for (std::size_t i = 0; i < fetches.size(); ++i) {
+        pending.emplace_back(i, fetches[i].steps());
+    }
+    return fetch<std::vector<T>>{
+        detail::fetching::all(std::vector<std::optional<T>>(fetches.size()), std::move(pending))};
+}
+
+}
+
+template <>
+struct functor<types::fetch> {
+
+    template <typename A, typename UnaryFunction>
+    static auto fmap(types::fetch<A> const &input, UnaryFunction f)
+        -> types::fetch<std::decay_t<decltype(f(std::declval<A &>()))>> {
+        return types::fetch<std::decay_t<decltype(f(std::declval<A &>()))>>{
+            detail::fetching::fmap(input.steps(), std::move(f))};
+    }
+};
+
+/**
+ * The applicative instance runs both fetches in the same round, so that their lookups are fetched together.
+ */
+template <>
+struct applicative<types::fetch> {
+
+    template <typename A, typename B, typename BinaryFunction>
+    static auto combine(types::fetch<A> const &first, types::fetch<B> const &second, BinaryFunction f)
+        -> types::fetch<std::decay_t<decltype(f(std::declval<A &>(), std::declval<B &>()))>> {
+        return types::fetch<std::decay_t<decltype(f(std::declval<A &>(), std::declval<B &>()))>>{
+            detail::fetching::combine(first.steps(), second.steps(), std::move(f))};
+    }
+
+    template <typename A>
+    static auto pure(A &&value) -> types::fetch<std::decay_t<A>> {
+        return types::fetch<std::decay_t<A>>{detail::fetching::pure(std::decay_t<A>(std::forward<A>(value)))};
+    }
+
+    template <typename A, typename... Args>
+    static auto pure_in_place(Args &&... args) -> types::fetch<A> {
+        return pure(A(std::forward<Args>(args)...));
+    }
+};
+
+/**
+ * The monad instance starts a new round whenever f depends on a value that's yet to be fetched.
+ */
+template <>
+struct monad<types::fetch> {
+
+    template <typename A, typename UnaryFunction>
+    static auto bind(types::fetch<A> const &input, UnaryFunction f) -> decltype(f(std::declval<A &>())) {
+        using B = typename decltype(f(std::declval<A &>()))::value_type;
+        return types::fetch<B>{bind(input.steps(), std::move(f))};
+    }
+
+    template <typename A>
+    static auto wrap(A &&value) -> types::fetch<std::decay_t<A>> {
+        return applicative<types::fetch>::pure(std::forward<A>(value));
+    }
+
+    template <typename A, typename... Args>
+    static auto wrap_in_place(Args &&... args) -> types::fetch<A> {
+        return applicative<types::fetch>::pure_in_place<A>(std::forward<Args>(args)...);
+    }
+
+    template <typename UnaryFunctionA, typename UnaryFunctionB>
+    static auto compose(UnaryFunctionA f, UnaryFunctionB g) {
+        return detail::deriving::compose<types::fetch>(std::move(f), std::move(g));
+    }
+
+  private:
+    template <typename A, typename UnaryFunction,
+              typename B = typename decltype(std::declval<UnaryFunction &>()(std::declval<A &>()))::value_type>
+    static detail::fetching::step<B> bind(detail::fetching::step<A> input, UnaryFunction f) {
+        return [input = std::move(input), f = std::move(f)]() mutable -> detail::fetching::progress<B> {
+            auto p = input();
+            if (p.value.has_value()) {
+                return f(*p.value).steps()();
+            }
+            return detail::fetching::blocked<B>(std::move(p.blocked_on), bind(std::move(p.rest), f));
+        };
+    }
+};
+
+namespace traits {
+template <>
+struct is_functor<types::fetch> : std::true_type {};
+
+template <>
+struct is_applicative<types::fetch> : std::true_type {};
+
+template <>
+struct is_monad<types::fetch> : std::true_type {};
+}
+
+}
+
+#endif
@@ -18,7 +18,8 @@ class function_wrapper {
     }
 
     template <typename... Args>
-    constexpr auto operator()(Args &&... args) const noexcept -> decltype(f(std::forward<Args>(args)...)) {
+    constexpr auto operator()(Args &&... args) const noexcept(noexcept(f(std::forward<Args>(args)...)))
+        -> decltype(f(std::forward<Args>(args)...)) {
         return f(std::forward<Args>(args)...);
     }
 };
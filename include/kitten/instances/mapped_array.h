@@ -0,0 +1,324 @@
+#ifndef RVARAGO_KITTEN_MAPPED_ARRAY_H
+#define RVARAGO_KITTEN_MAPPED_ARRAY_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "kitten/foldable.h"
+#include "kitten/functor.h"
+#include "kitten/monad.h"
+
+#include "kitten/detail/ranges/algorithm.h"
+
+namespace rvarago::kitten {
+
+namespace detail::posix {
+
+[[noreturn]] inline void throw_last_error(char const *what) {
+    throw std::system_error{errno, std::generic_category(), what};
+}
+
+class file_descriptor {
+    int fd;
+
+  public:
+    file_descriptor(std::string const &path, int flags, mode_t mode = 0) : fd{::open(path.c_str(), flags, mode)} {
+        if (fd < 0) {
+            throw_last_error("open");
+        }
+    }
+
+    file_descriptor(file_descriptor const &) = delete;
+    file_descriptor &operator=(file_descriptor const &) = delete;
+
+    ~file_descriptor() {
+        ::close(fd);
+    }
+
+    int get() const noexcept {
+        return fd;
+    }
+};
+
+/**
+ * A shared read-write memory mapping of the first length bytes of a file, unmapped on destruction.
+ */
+class mapping {
+    void *address;
+    std::size_t length;
+
+  public:
+    mapping(file_descriptor const &file, std::size_t length)
+        : address{::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, file.get(), 0)}, length{length} {
+        if (address == MAP_FAILED) {
+            throw_last_error("mmap");
+        }
+    }
+
+    mapping(mapping const &) = delete;
+    mapping &operator=(mapping const &) = delete;
+
+    ~mapping() {
+        ::munmap(address, length);
+    }
+
+    void *get() const noexcept {
+        return address;
+    }
+};
+
+inline std::size_t page_size() noexcept {
+    static auto const size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+/**
+ * Advises the kernel about the usage of the pages spanned by [begin, end), which are expanded to page boundaries.
+ * Advice is only a hint, so failures are ignored.
+ */
+inline void advise(void const *begin, void const *end, int advice) noexcept {
+    auto const first = reinterpret_cast<std::uintptr_t>(begin) / page_size() * page_size();
+    auto const last = reinterpret_cast<std::uintptr_t>(end);
+    if (last > first) {
+        ::madvise(reinterpret_cast<void *>(first), last - first, advice);
+    }
+}
+
+}
+
+namespace types {
+
+/**
+ * A read-only array of trivially-copyable records memory-mapped from a binary file.
+ *
+ * The file is mapped with a sequential access hint, and the combinators traverse it in chunks, releasing the pages of
+ * each chunk once it has been processed, so that the resident set stays bounded by the chunk size rather than the
+ * file size.
+ */
+template <typename T>
+class mapped_array {
+    static_assert(std::is_trivially_copyable_v<T>, "records of a mapped_array must be trivially copyable");
+
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using const_iterator = T const *;
+    using iterator = const_iterator;
+
+    static constexpr size_type default_chunk_bytes = 16 * 1024 * 1024;
+
+    explicit mapped_array(std::string const &path) {
+        auto const file = detail::posix::file_descriptor{path, O_RDONLY};
+        struct stat status {};
+        if (::fstat(file.get(), &status) != 0) {
+            detail::posix::throw_last_error("fstat");
+        }
+        auto const length = static_cast<size_type>(status.st_size);
+        if (length % sizeof(T) != 0) {
+            throw std::invalid_argument{"size of " + path + " is not a multiple of the record size"};
+        }
+        if (length == 0) {
+            return;
+        }
+        auto *const address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file.get(), 0);
+        if (address == MAP_FAILED) {
+            detail::posix::throw_last_error("mmap");
+        }
+        ::madvise(address, length, MADV_SEQUENTIAL);
+        records = static_cast<T const *>(address);
+        count = length / sizeof(T);
+    }
+
+    mapped_array(mapped_array &&other) noexcept
+        : records{std::exchange(other.records, nullptr)}, count{std::exchange(other.count, 0)} {
+    }
+
+    mapped_array &operator=(mapped_array &&other) noexcept {
+        if (this != &other) {
+            unmap();
+            records = std::exchange(other.records, nullptr);
+            count = std::exchange(other.count, 0);
+        }
+        return *this;
+    }
+
+    mapped_array(mapped_array const &) = delete;
+    mapped_array &operator=(mapped_array const &) = delete;
+
+    ~mapped_array() {
+        unmap();
+    }
+
+    size_type size() const noexcept {
+        return count;
+    }
+
+    bool empty() const noexcept {
+        return count == 0;
+    }
+
+    T const *data() const noexcept {
+        return records;
+    }
+
+    T const &operator[](size_type i) const noexcept {
+        return records[i];
+    }
+
+    const_iterator begin() const noexcept {
+        return records;
+    }
+
+    const_iterator end() const noexcept {
+        return records + count;
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    /**
+     * Feeds the records into f as consecutive [begin, end) chunks of about chunk_bytes, prefetching the next chunk and
+     * releasing the pages of each chunk after f returns.
+     */
+    template <typename ChunkFunction>
+    void for_each_chunk(ChunkFunction f, size_type chunk_bytes = default_chunk_bytes) const {
+        auto const chunk_records = std::max<size_type>(1, chunk_bytes / sizeof(T));
+        for (auto first = begin(); first != end();) {
+            auto const last = first + std::min<size_type>(chunk_records, end() - first);
+            detail::posix::advise(last, last + std::min<size_type>(chunk_records, end() - last), MADV_WILLNEED);
+            f(first, last);
+            detail::posix::advise(first, last, MADV_DONTNEED);
+            first = last;
+        }
+    }
+
+  private:
+    void unmap() noexcept {
+        if (records != nullptr) {
+            ::munmap(const_cast<T *>(records), count * sizeof(T));
+        }
+    }
+
+    T const *records{nullptr};
+    size_type count{0};
+};
+
+}
+
+/**
+ * Maps f over every record of input and writes the results as records into the file at path, which is memory-mapped
+ * for writing, and then returns it mapped again as a read-only mapped_array. Both input and output are processed in
+ * chunks, so the resident set stays bounded regardless of the file sizes.
+ *
+ * @param input a mapped array of records of type A
+ * @param path the path of the output file, truncated if it already exists
+ * @param f a function A -> B, where B is trivially copyable
+ * @return a read-only mapped array over the written records of type B
+ * @throws if the output file can't be written, or if f throws, in which case the output file is removed
+ */
+template <typename A, typename UnaryFunction>
+auto fmap_to_file(types::mapped_array<A> const &input, std::string const &path, UnaryFunction f)
+    -> types::mapped_array<decltype(f(std::declval<A>()))> {
+    using B = decltype(f(std::declval<A>()));
+    static_assert(std::is_trivially_copyable_v<B>, "records of a mapped_array must be trivially copyable");
+    auto const file = detail::posix::file_descriptor{path, O_RDWR | O_CREAT | O_TRUNC, 0644};
+    try {
+        auto const length = input.size() * sizeof(B);
+        if (length != 0) {
+            if (::ftruncate(file.get(), static_cast<off_t>(length)) != 0) {
+                detail::posix::throw_last_error("ftruncate");
+            }
+            auto const output = detail::posix::mapping{file, length};
+            auto *out = static_cast<B *>(output.get());
+            input.for_each_chunk([&out, &f](auto first, auto last) {
+                auto *const out_first = out;
+                out = std::transform(first, last, out, f);
+                detail::posix::advise(out_first, out, MADV_DONTNEED);
+            });
+        }
+    } catch (...) {
+        ::unlink(path.c_str());
+        throw;
+    }
+    return types::mapped_array<B>{path};
+}
+
+/**
+ * A mapped_array is only a source of records, so its instances produce an std::vector, or, via fmap_to_file, a new
+ * mapped_array.
+ */
+template <>
+struct functor<types::mapped_array> {
+
+    template <typename A, typename UnaryFunction>
+    static auto fmap(types::mapped_array<A> const &input, UnaryFunction f)
+        -> std::vector<decltype(f(std::declval<A>()))> {
+        auto mapped = std::vector<decltype(f(std::declval<A>()))>{};
+        mapped.reserve(input.size());
+        input.for_each_chunk(
+            [&mapped, &f](auto first, auto last) { std::transform(first, last, std::back_inserter(mapped), f); });
+        return mapped;
+    }
+};
+
+template <>
+struct monad<types::mapped_array> {
+
+    template <typename A, typename UnaryFunction>
+    static auto bind(types::mapped_array<A> const &input, UnaryFunction f) -> decltype(f(std::declval<A>())) {
+        using namespace detail::ranges;
+        auto mapped_sequence = decltype(f(std::declval<A>())){};
+        input.for_each_chunk([&mapped_sequence, &f](auto first, auto last) {
+            std::for_each(first, last, [&](auto const &e) { append(f(e), mapped_sequence); });
+        });
+        return mapped_sequence;
+    }
+};
+
+template <>
+struct foldable<types::mapped_array> {
+
+    template <typename A, typename B, typename BinaryFunction>
+    static auto fold(types::mapped_array<A> const &input, B init, BinaryFunction f) -> B {
+        input.for_each_chunk([&init, &f](auto first, auto last) {
+            for (; first != last; ++first) {
+                init = f(std::move(init), *first);
+            }
+        });
+        return init;
+    }
+};
+
+namespace traits {
+template <>
+struct is_functor<types::mapped_array> : std::true_type {};
+
+template <>
+struct is_monad<types::mapped_array> : std::true_type {};
+
+template <>
+struct is_foldable<types::mapped_array> : std::true_type {};
+}
+
+}
+
+#endif
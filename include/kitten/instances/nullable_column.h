@@ -0,0 +1,277 @@
+#ifndef RVARAGO_KITTEN_NULLABLE_COLUMN_H
+#define RVARAGO_KITTEN_NULLABLE_COLUMN_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "kitten/applicative.h"
+#include "kitten/functor.h"
+
+namespace rvarago::kitten {
+
+namespace types {
+
+/**
+ * A column of optional values laid out as a struct-of-arrays: a dense array with one value per element and a bitmap
+ * that tells which elements are present.
+ *
+ * It behaves as an std::vector<std::optional<T>>, but without paying for the padding of each optional, and it allows
+ * the values to be processed by branch-free loops. Empty elements hold a value-initialized T as a placeholder.
+ */
+template <typename T>
+class nullable_column {
+  public:
+    using word_type = std::uint64_t;
+
+    static constexpr std::size_t bits_per_word = 64;
+
+    nullable_column() = default;
+
+    nullable_column(std::vector<T> values, std::vector<word_type> validity)
+        : data(std::move(values)), mask(std::move(validity)) {
+        mask.resize(words_for(data.size()));
+        clear_trailing_bits();
+    }
+
+    explicit nullable_column(std::vector<std::optional<T>> const &optionals) : mask(words_for(optionals.size())) {
+        data.reserve(optionals.size());
+        for (std::size_t i = 0; i < optionals.size(); ++i) {
+            data.push_back(optionals[i].value_or(T{}));
+            mask[i / bits_per_word] |= word_type{optionals[i].has_value()} << (i % bits_per_word);
+        }
+    }
+
+    static constexpr std::size_t words_for(std::size_t size) noexcept {
+        return (size + bits_per_word - 1) / bits_per_word;
+    }
+
+    std::size_t size() const noexcept {
+        return data.size();
+    }
+
+    bool empty() const noexcept {
+        return data.empty();
+    }
+
+    bool has_value(std::size_t i) const noexcept {
+        return (mask[i / bits_per_word] >> (i % bits_per_word)) & word_type{1};
+    }
+
+    std::optional<T> operator[](std::size_t i) const {
+        return has_value(i) ? std::optional<T>{data[i]} : std::nullopt;
+    }
+
+    void push_back(std::optional<T> value) {
+        if (value.has_value()) {
+            emplace_back(std::move(*value));
+        } else {
+            append_validity(false);
+            data.emplace_back();
+        }
+    }
+
+    /**
+     * Appends a present element constructed in place from args.
+     */
+    template <typename... Args>
+    void emplace_back(Args &&... args) {
+        append_validity(true);
+        data.emplace_back(std::forward<Args>(args)...);
+    }
+
+    std::vector<T> const &values() const noexcept {
+        return data;
+    }
+
+    std::vector<word_type> const &validity() const noexcept {
+        return mask;
+    }
+
+    std::vector<std::optional<T>> to_optionals() const {
+        auto optionals = std::vector<std::optional<T>>{};
+        optionals.reserve(size());
+        for (std::size_t i = 0; i < size(); ++i) {
+            optionals.push_back((*this)[i]);
+        }
+        return optionals;
+    }
+
+    friend bool operator==(nullable_column const &first, nullable_column const &second) {
+        if (first.size() != second.size() || first.mask != second.mask) {
+            return false;
+        }
+        for (std::size_t i = 0; i < first.size(); ++i) {
+            if (first.has_value(i) && !(first.data[i] == second.data[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend bool operator!=(nullable_column const &first, nullable_column const &second) {
+        return !(first == second);
+    }
+
+  private:
+    void append_validity(bool present) {
+        if (data.size() % bits_per_word == 0) {
+            mask.push_back(0);
+        }
+        mask.back() |= word_type{present} << (data.size() % bits_per_word);
+    }
+
+    void clear_trailing_bits() noexcept {
+        if (auto const tail = data.size() % bits_per_word; tail != 0) {
+            mask.back() &= (word_type{1} << tail) - 1;
+        }
+    }
+
+    std::vector<T> data;
+    std::vector<word_type> mask;
+};
+
+/**
+ * A function that's marked as defined for every value of its domain, including the placeholders of the empty elements
+ * of a nullable_column, which fmap and combine then apply to every value in a single branch-free loop.
+ */
+template <typename Function>
+class total {
+  public:
+    explicit total(Function f) : f(std::move(f)) {
+    }
+
+    template <typename... Args>
+    auto operator()(Args &&... args) const -> decltype(std::declval<Function const &>()(std::forward<Args>(args)...)) {
+        return f(std::forward<Args>(args)...);
+    }
+
+  private:
+    Function f;
+};
+
+}
+
+namespace detail {
+
+template <typename Function>
+struct is_total : std::false_type {};
+
+template <typename Function>
+struct is_total<types::total<Function>> : std::true_type {};
+
+template <typename Word>
+std::size_t lowest_present(Word word) noexcept {
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_ctzll(static_cast<unsigned long long>(word)));
+#else
+    auto position = std::size_t{0};
+    for (; (word & Word{1}) == 0; word >>= 1) {
+        ++position;
+    }
+    return position;
+#endif
+}
+
+/**
+ * Feeds the position of each present element among the first size elements of validity into f, jumping from one set
+ * bit to the next, so that a word without any present element costs a single test.
+ */
+template <typename Word, typename UnaryFunction>
+void for_each_present(std::vector<Word> const &validity, std::size_t size, UnaryFunction f) {
+    constexpr auto bits = std::size_t{sizeof(Word) * 8};
+    for (std::size_t w = 0; w * bits < size; ++w) {
+        for (auto word = validity[w]; word != 0; word &= word - 1) {
+            f(w * bits + lowest_present(word));
+        }
+    }
+}
+
+}
+
+template <>
+struct applicative<types::nullable_column> {
+
+    /**
+     * Combines both columns element-wise, i.e. as if combining the std::optional at each position. The output has
+     * the length of the shortest column, and its validity bitmap is the AND of both bitmaps.
+     *
+     * f is only applied where both elements are present, unless it's wrapped in types::total, in which case it's
+     * applied to every pair of values, placeholders included, in a single branch-free loop.
+     */
+    template <typename A, typename B, typename BinaryFunction>
+    static auto combine(types::nullable_column<A> const &first, types::nullable_column<B> const &second,
+                        BinaryFunction f) -> types::nullable_column<decltype(f(std::declval<A>(), std::declval<B>()))> {
+        using C = decltype(f(std::declval<A>(), std::declval<B>()));
+        auto const size = std::min(first.size(), second.size());
+        auto const words = types::nullable_column<C>::words_for(size);
+        auto validity = std::vector<typename types::nullable_column<C>::word_type>(
+            first.validity().cbegin(), first.validity().cbegin() + words);
+        std::transform(validity.cbegin(), validity.cend(), second.validity().cbegin(), validity.begin(),
+                       std::bit_and<>{});
+        auto values = std::vector<C>(size);
+        if constexpr (detail::is_total<BinaryFunction>::value) {
+            std::transform(first.values().cbegin(), first.values().cbegin() + size, second.values().cbegin(),
+                           values.begin(), f);
+        } else {
+            detail::for_each_present(validity, size, [&](std::size_t i) {
+                values[i] = f(first.values()[i], second.values()[i]);
+            });
+        }
+        return types::nullable_column<C>{std::move(values), std::move(validity)};
+    }
+
+    template <typename A>
+    static auto pure(A &&value) -> types::nullable_column<std::decay_t<A>> {
+        return pure_in_place<std::decay_t<A>>(std::forward<A>(value));
+    }
+
+    template <typename A, typename... Args>
+    static auto pure_in_place(Args &&... args) -> types::nullable_column<A> {
+        auto column = types::nullable_column<A>{};
+        column.emplace_back(std::forward<Args>(args)...);
+        return column;
+    }
+};
+
+template <>
+struct functor<types::nullable_column> {
+
+    /**
+     * Maps f over the present values, visiting them one word of the validity bitmap at a time, and then copies the
+     * validity bitmap across.
+     *
+     * When f is wrapped in types::total, it's instead applied to every value, placeholders included, as a single
+     * branch-free loop over the dense array that's amenable to auto-vectorization.
+     */
+    template <typename A, typename UnaryFunction>
+    static auto fmap(types::nullable_column<A> const &input, UnaryFunction f)
+        -> types::nullable_column<decltype(f(std::declval<A>()))> {
+        using B = decltype(f(std::declval<A>()));
+        auto values = std::vector<B>(input.size());
+        if constexpr (detail::is_total<UnaryFunction>::value) {
+            std::transform(input.values().cbegin(), input.values().cend(), values.begin(), f);
+        } else {
+            detail::for_each_present(input.validity(), input.size(),
+                                     [&](std::size_t i) { values[i] = f(input.values()[i]); });
+        }
+        return types::nullable_column<B>{std::move(values), input.validity()};
+    }
+};
+
+namespace traits {
+template <>
+struct is_applicative<types::nullable_column> : std::true_type {};
+
+template <>
+struct is_functor<types::nullable_column> : std::true_type {};
+}
+
+}
+
+#endif
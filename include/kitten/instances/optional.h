@@ -2,6 +2,8 @@
 #define RVARAGO_KITTEN_OPTIONAL_H
 
 #include <optional>
+#include <type_traits>
+#include <utility>
 
 #include "kitten/applicative.h"
 #include "kitten/functor.h"
@@ -24,8 +26,29 @@ struct monad<std::optional> {
     }
 
     template <typename A>
-    static constexpr auto wrap(A &&value) -> std::optional<A> {
-        return std::make_optional(std::forward<A>(value));
+    static constexpr auto wrap(A &&value) -> std::optional<std::decay_t<A>> {
+        return wrap_in_place<std::decay_t<A>>(std::forward<A>(value));
+    }
+
+    template <typename A, typename... Args>
+    static constexpr auto wrap_in_place(Args &&... args) -> std::optional<A> {
+        return std::optional<A>{std::in_place, std::forward<Args>(args)...};
+    }
+
+    /**
+     * Fuses f: A -> optional[B] and g: B -> optional[C] into a chain of branches, where the intermediate value is
+     * moved into g rather than copied out of the optional returned by f.
+     */
+    template <typename UnaryFunctionA, typename UnaryFunctionB>
+    static constexpr auto compose(UnaryFunctionA f, UnaryFunctionB g) {
+        return [f = std::move(f), g = std::move(g)](auto &&value)
+                   -> decltype(g(*f(std::forward<decltype(value)>(value)))) {
+            auto intermediate = f(std::forward<decltype(value)>(value));
+            if (!intermediate.has_value()) {
+                return std::nullopt;
+            }
+            return g(std::move(*intermediate));
+        };
     }
 };
 
@@ -39,9 +62,14 @@ struct applicative<std::optional> {
     }
 
     template <typename A>
-    static constexpr auto pure(A &&value) -> std::optional<A> {
+    static constexpr auto pure(A &&value) -> std::optional<std::decay_t<A>> {
         return detail::deriving::pure<std::optional>(std::forward<A>(value));
     }
+
+    template <typename A, typename... Args>
+    static constexpr auto pure_in_place(Args &&... args) -> std::optional<A> {
+        return detail::deriving::pure_in_place<std::optional, A>(std::forward<Args>(args)...);
+    }
 };
 
 template <>
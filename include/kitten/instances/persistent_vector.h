@@ -0,0 +1,512 @@
+#ifndef RVARAGO_KITTEN_PERSISTENT_VECTOR_H
+#define RVARAGO_KITTEN_PERSISTENT_VECTOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "kitten/applicative.h"
+#include "kitten/functor.h"
+#include "kitten/monad.h"
+
+#include "kitten/detail/deriving/from_monad/derive_kleisli.h"
+
+namespace rvarago::kitten {
+
+namespace types {
+
+/**
+ * An immutable sequence stored as a 32-way radix-balanced trie, where every update returns a new version that shares
+ * all the unchanged subtrees with the previous one, so set and push_back copy only O(log32 n) nodes.
+ *
+ * Nodes are never modified once they're reachable from a persistent_vector, so versions can be read concurrently
+ * from several threads. For batches of updates, a transient mutates the nodes that it has itself created in place,
+ * and is turned back into a persistent_vector once the batch is done.
+ */
+template <typename T>
+class persistent_vector {
+    static constexpr unsigned bits = 5;
+    static constexpr std::size_t branching = std::size_t{1} << bits;
+    static constexpr std::size_t mask = branching - 1;
+
+    struct node {
+        std::uint64_t owner{0};
+        std::vector<std::shared_ptr<node>> children;
+        std::vector<T> values;
+    };
+
+    using node_ptr = std::shared_ptr<node>;
+
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    class transient;
+
+    class const_iterator {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T const *;
+        using reference = T const &;
+
+        const_iterator() = default;
+
+        reference operator*() const noexcept {
+            return (*leaf)[index & mask];
+        }
+
+        pointer operator->() const noexcept {
+            return &**this;
+        }
+
+        const_iterator &operator++() noexcept {
+            if ((++index & mask) == 0 && index < vector->count) {
+                leaf = &vector->leaf_for(index);
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) noexcept {
+            auto previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        friend bool operator==(const_iterator const &first, const_iterator const &second) noexcept {
+            return first.index == second.index;
+        }
+
+        friend bool operator!=(const_iterator const &first, const_iterator const &second) noexcept {
+            return !(first == second);
+        }
+
+      private:
+        friend class persistent_vector;
+
+        const_iterator(persistent_vector const *owner, size_type position) noexcept
+            : vector{owner}, index{position},
+              leaf{position < owner->count ? &owner->leaf_for(position) : nullptr} {
+        }
+
+        persistent_vector const *vector{nullptr};
+        size_type index{0};
+        std::vector<T> const *leaf{nullptr};
+    };
+
+    using iterator = const_iterator;
+
+    persistent_vector() = default;
+
+    persistent_vector(persistent_vector const &) = default;
+
+    /**
+     * Leaves other empty, rather than with its size but without its nodes.
+     */
+    persistent_vector(persistent_vector &&other) noexcept
+        : root{std::move(other.root)}, shift{std::exchange(other.shift, 0)}, count{std::exchange(other.count, 0)} {
+    }
+
+    persistent_vector &operator=(persistent_vector const &) = default;
+
+    persistent_vector &operator=(persistent_vector &&other) noexcept {
+        if (this != &other) {
+            root = std::move(other.root);
+            shift = std::exchange(other.shift, 0);
+            count = std::exchange(other.count, 0);
+        }
+        return *this;
+    }
+
+    persistent_vector(std::initializer_list<T> values) {
+        auto batch = transient{std::move(*this)};
+        for (auto const &value : values) {
+            batch.push_back(value);
+        }
+        *this = std::move(batch).persistent();
+    }
+
+    size_type size() const noexcept {
+        return count;
+    }
+
+    bool empty() const noexcept {
+        return count == 0;
+    }
+
+    T const &operator[](size_type i) const noexcept {
+        return leaf_for(i)[i & mask];
+    }
+
+    T const &at(size_type i) const {
+        if (i >= count) {
+            throw std::out_of_range{"persistent_vector::at"};
+        }
+        return (*this)[i];
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator{this, 0};
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator{this, count};
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    /**
+     * @return a new version where the i-th value is replaced by value, sharing every other subtree with this one
+     */
+    persistent_vector set(size_type i, T value) const {
+        if (i >= count) {
+            throw std::out_of_range{"persistent_vector::set"};
+        }
+        auto updated = *this;
+        updated.root = assoc(root, shift, i, std::move(value), 0);
+        return updated;
+    }
+
+    /**
+     * @return a new version with value appended, sharing every full subtree with this one
+     */
+    persistent_vector push_back(T value) const {
+        auto updated = *this;
+        updated.append(std::move(value), 0);
+        return updated;
+    }
+
+    /**
+     * @return a transient that starts from this version, which is left untouched
+     */
+    transient as_transient() const {
+        return transient{*this};
+    }
+
+    friend bool operator==(persistent_vector const &first, persistent_vector const &second) {
+        if (first.count != second.count) {
+            return false;
+        }
+        for (auto i = first.begin(), j = second.begin(); i != first.end(); ++i, ++j) {
+            if (!(*i == *j)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend bool operator!=(persistent_vector const &first, persistent_vector const &second) {
+        return !(first == second);
+    }
+
+    /**
+     * A mutable view over a persistent_vector that updates in place every node it has created itself, and copies the
+     * nodes it shares with other versions on their first update.
+     */
+    class transient {
+      public:
+        explicit transient(persistent_vector initial) : vector{std::move(initial)}, owner{next_owner()} {
+        }
+
+        transient(transient &&) noexcept = default;
+        transient &operator=(transient &&) noexcept = default;
+
+        transient(transient const &) = delete;
+        transient &operator=(transient const &) = delete;
+
+        size_type size() const noexcept {
+            return vector.size();
+        }
+
+        T const &operator[](size_type i) const noexcept {
+            return vector[i];
+        }
+
+        void set(size_type i, T value) {
+            if (i >= vector.count) {
+                throw std::out_of_range{"persistent_vector::transient::set"};
+            }
+            vector.root = assoc(vector.root, vector.shift, i, std::move(value), owner);
+        }
+
+        void push_back(T value) {
+            vector.append(std::move(value), owner);
+        }
+
+        /**
+         * Freezes every node created so far, such that this transient can't change them anymore.
+         */
+        persistent_vector persistent() && {
+            owner = 0;
+            return std::move(vector);
+        }
+
+      private:
+        static std::uint64_t next_owner() noexcept {
+            static auto counter = std::atomic<std::uint64_t>{0};
+            return ++counter;
+        }
+
+        persistent_vector vector;
+        std::uint64_t owner;
+    };
+
+    /**
+     * Maps the values at positions via f into a new version that shares with this one every subtree holding none of
+     * them, which is never visited, so only the paths leading to positions are copied.
+     *
+     * @throws std::out_of_range if a position is out of bounds
+     */
+    template <typename UnaryFunction>
+    persistent_vector map_at(std::vector<size_type> positions, UnaryFunction f) const {
+        std::sort(positions.begin(), positions.end());
+        positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+        if (!positions.empty() && positions.back() >= count) {
+            throw std::out_of_range{"persistent_vector::map_at"};
+        }
+        auto mapped = *this;
+        if (!positions.empty()) {
+            mapped.root = map_positions(root, shift, positions.data(), positions.data() + positions.size(), f);
+        }
+        return mapped;
+    }
+
+    template <typename UnaryFunction>
+    auto map(UnaryFunction f) const -> persistent_vector<std::decay_t<decltype(f(std::declval<T>()))>> {
+        using B = std::decay_t<decltype(f(std::declval<T>()))>;
+        auto mapped = persistent_vector<B>{};
+        mapped.root = root ? map_node<B>(root, f) : nullptr;
+        mapped.shift = shift;
+        mapped.count = count;
+        return mapped;
+    }
+
+  private:
+    template <typename>
+    friend class persistent_vector;
+
+    std::vector<T> const &leaf_for(size_type i) const noexcept {
+        auto const *current = root.get();
+        for (auto level = shift; level > 0; level -= bits) {
+            current = current->children[(i >> level) & mask].get();
+        }
+        return current->values;
+    }
+
+    static node_ptr editable(node_ptr const &current, std::uint64_t owner) {
+        if (owner != 0 && current->owner == owner) {
+            return current;
+        }
+        auto copy = std::make_shared<node>(*current);
+        copy->owner = owner;
+        return copy;
+    }
+
+    static node_ptr assoc(node_ptr const &current, unsigned level, size_type i, T value, std::uint64_t owner) {
+        auto updated = editable(current, owner);
+        if (level == 0) {
+            updated->values[i & mask] = std::move(value);
+        } else {
+            auto &child = updated->children[(i >> level) & mask];
+            child = assoc(child, level - bits, i, std::move(value), owner);
+        }
+        return updated;
+    }
+
+    static node_ptr push(node_ptr const &current, unsigned level, size_type i, T value, std::uint64_t owner) {
+        auto updated = current ? editable(current, owner) : std::make_shared<node>();
+        updated->owner = owner;
+        if (level == 0) {
+            updated->values.reserve(branching);
+            updated->values.push_back(std::move(value));
+            return updated;
+        }
+        auto const child_index = (i >> level) & mask;
+        if (child_index == updated->children.size()) {
+            updated->children.push_back(push(nullptr, level - bits, i, std::move(value), owner));
+        } else {
+            auto &child = updated->children[child_index];
+            child = push(child, level - bits, i, std::move(value), owner);
+        }
+        return updated;
+    }
+
+    void append(T value, std::uint64_t owner) {
+        if (root && count == (size_type{1} << (shift + bits))) {
+            auto grown = std::make_shared<node>();
+            grown->owner = owner;
+            grown->children.push_back(std::move(root));
+            root = std::move(grown);
+            shift += bits;
+        }
+        root = push(root, shift, count, std::move(value), owner);
+        ++count;
+    }
+
+    /**
+     * Copies current, and maps the values at the sorted positions in [first, last), all within the subtree of current,
+     * by copying only the children that hold them.
+     */
+    template <typename UnaryFunction>
+    static node_ptr map_positions(node_ptr const &current, unsigned level, size_type const *first,
+                                  size_type const *last, UnaryFunction &f) {
+        auto updated = std::make_shared<node>(*current);
+        updated->owner = 0;
+        if (level == 0) {
+            for (; first != last; ++first) {
+                auto &value = updated->values[*first & mask];
+                value = f(std::as_const(value));
+            }
+            return updated;
+        }
+        while (first != last) {
+            auto const child = (*first >> level) & mask;
+            auto next = first;
+            while (next != last && ((*next >> level) & mask) == child) {
+                ++next;
+            }
+            updated->children[child] = map_positions(current->children[child], level - bits, first, next, f);
+            first = next;
+        }
+        return updated;
+    }
+
+    template <typename B, typename UnaryFunction>
+    static auto map_node(node_ptr const &current, UnaryFunction &f) -> typename persistent_vector<B>::node_ptr {
+        auto mapped = std::make_shared<typename persistent_vector<B>::node>();
+        if (current->children.empty()) {
+            mapped->values.reserve(current->values.size());
+            for (auto const &value : current->values) {
+                mapped->values.push_back(f(value));
+            }
+        } else {
+            mapped->children.reserve(current->children.size());
+            for (auto const &child : current->children) {
+                mapped->children.push_back(map_node<B>(child, f));
+            }
+        }
+        return mapped;
+    }
+
+    node_ptr root;
+    unsigned shift{0};
+    size_type count{0};
+};
+
+}
+
+/**
+ * Maps f: T -> T over the values of input at positions only, sharing with input every subtree that holds none of them.
+ * Such subtrees are never visited, so an update touching k values calls f k times and copies O(k log32 n) nodes.
+ *
+ * @param input a persistent_vector of values of type T
+ * @param f a function T -> T
+ * @param positions the positions of the values to map, in any order and possibly repeated, each one mapped once
+ * @return a new version where the value at each of positions is mapped via f
+ * @throws std::out_of_range if a position is out of bounds
+ */
+template <typename T, typename UnaryFunction>
+auto fmap_sharing(types::persistent_vector<T> const &input, UnaryFunction f,
+                  std::vector<std::size_t> positions) -> types::persistent_vector<T> {
+    return input.map_at(std::move(positions), f);
+}
+
+template <>
+struct monad<types::persistent_vector> {
+
+    template <typename A, typename UnaryFunction>
+    static auto bind(types::persistent_vector<A> const &input, UnaryFunction f) -> decltype(f(std::declval<A>())) {
+        auto batch = decltype(f(std::declval<A>())){}.as_transient();
+        for (auto const &e : input) {
+            for (auto const &mapped : f(e)) {
+                batch.push_back(mapped);
+            }
+        }
+        return std::move(batch).persistent();
+    }
+
+    template <typename A>
+    static auto wrap(A &&value) -> types::persistent_vector<std::decay_t<A>> {
+        return wrap_in_place<std::decay_t<A>>(std::forward<A>(value));
+    }
+
+    template <typename A, typename... Args>
+    static auto wrap_in_place(Args &&... args) -> types::persistent_vector<A> {
+        return types::persistent_vector<A>{}.push_back(A(std::forward<Args>(args)...));
+    }
+
+    template <typename UnaryFunctionA, typename UnaryFunctionB>
+    static auto compose(UnaryFunctionA f, UnaryFunctionB g) {
+        return detail::deriving::compose<types::persistent_vector>(std::move(f), std::move(g));
+    }
+};
+
+template <>
+struct applicative<types::persistent_vector> {
+
+    template <typename A, typename B, typename BinaryFunction>
+    static auto combine(types::persistent_vector<A> const &first, types::persistent_vector<B> const &second,
+                        BinaryFunction f)
+        -> types::persistent_vector<decltype(f(std::declval<A>(), std::declval<B>()))> {
+        auto batch = types::persistent_vector<decltype(f(std::declval<A>(), std::declval<B>()))>{}.as_transient();
+        for (auto const &first_value : first) {
+            for (auto const &second_value : second) {
+                batch.push_back(f(first_value, second_value));
+            }
+        }
+        return std::move(batch).persistent();
+    }
+
+    template <typename A>
+    static auto pure(A &&value) -> types::persistent_vector<std::decay_t<A>> {
+        return monad<types::persistent_vector>::wrap(std::forward<A>(value));
+    }
+
+    template <typename A, typename... Args>
+    static auto pure_in_place(Args &&... args) -> types::persistent_vector<A> {
+        return monad<types::persistent_vector>::wrap_in_place<A>(std::forward<Args>(args)...);
+    }
+};
+
+template <>
+struct functor<types::persistent_vector> {
+
+    /**
+     * Maps every value into a new trie with the same shape, so no rebalancing is needed.
+     */
+    template <typename A, typename UnaryFunction>
+    static auto fmap(types::persistent_vector<A> const &input, UnaryFunction f)
+        -> types::persistent_vector<decltype(f(std::declval<A>()))> {
+        return input.map(f);
+    }
+};
+
+namespace traits {
+template <>
+struct is_monad<types::persistent_vector> : std::true_type {};
+
+template <>
+struct is_applicative<types::persistent_vector> : std::true_type {};
+
+template <>
+struct is_functor<types::persistent_vector> : std::true_type {};
+}
+
+}
+
+#endif
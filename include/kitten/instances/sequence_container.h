@@ -1,19 +1,29 @@
 #ifndef RVARAGO_KITTEN_SEQUENCE_CONTAINER_H
 #define RVARAGO_KITTEN_SEQUENCE_CONTAINER_H
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <deque>
+#include <iterator>
 #include <list>
+#include <stdexcept>
+#include <string>
 #include <type_traits>
 #include <vector>
 
 #include "kitten/applicative.h"
+#include "kitten/comonad.h"
+#include "kitten/foldable.h"
 #include "kitten/functor.h"
 #include "kitten/monad.h"
 
 #include "kitten/detail/deriving/from_monad/derive_applicative.h"
-#include "kitten/detail/deriving/from_monad/derive_functor.h"
 
 #include "kitten/detail/ranges/algorithm.h"
+#include "kitten/detail/simd/byte_table.h"
 
 namespace rvarago::kitten {
 
@@ -32,9 +42,140 @@ struct is_sequence_container<std::list> : std::true_type {};
 template <>
 struct is_sequence_container<std::vector> : std::true_type {};
 
+template <>
+struct is_sequence_container<std::basic_string> : std::true_type {};
+
 template <template <typename...> typename Container>
 using enable_if_sequence_container = typename std::enable_if_t<is_sequence_container<Container>::value>;
 
+template <typename T>
+inline constexpr bool is_character_v =
+    std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char> ||
+    std::is_same_v<T, wchar_t> || std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t>
+#if defined(__cpp_char8_t)
+    || std::is_same_v<T, char8_t>
+#endif
+    ;
+
+template <template <typename...> typename Container>
+struct is_basic_string : std::false_type {};
+
+template <>
+struct is_basic_string<std::basic_string> : std::true_type {};
+
+/**
+ * Tells whether Container can hold values of type T, which, for std::basic_string, must be a character type since
+ * std::char_traits is only defined for them.
+ */
+template <template <typename...> typename Container, typename T>
+inline constexpr bool holds_v = !is_basic_string<Container>::value || is_character_v<T>;
+
+template <template <typename...> typename Container, typename T>
+using enable_if_holds = std::enable_if_t<holds_v<Container, T>>;
+
+template <template <typename...> typename Container, typename T>
+using enable_if_not_holds = std::enable_if_t<!holds_v<Container, T>>;
+
+template <typename Container>
+inline constexpr bool is_random_access_v = std::is_base_of_v<
+    std::random_access_iterator_tag, typename std::iterator_traits<typename Container::iterator>::iterator_category>;
+
+template <typename Container>
+inline constexpr bool is_contiguous_v = std::is_same_v<Container, std::vector<typename Container::value_type>> ||
+                                        std::is_same_v<Container, std::basic_string<typename Container::value_type>>;
+
+/**
+ * Tells whether Container can be filtered by writing every value into a pre-sized output, via detail::ranges::compact,
+ * which excludes the proxy references of std::vector<bool>.
+ */
+template <typename Container>
+inline constexpr bool is_compactable_v = std::is_arithmetic_v<typename Container::value_type> &&
+                                         !std::is_same_v<typename Container::value_type, bool> &&
+                                         is_random_access_v<Container>;
+
+template <typename Container>
+void reserve(Container &container, std::size_t capacity) {
+    if constexpr (is_contiguous_v<Container>) {
+        container.reserve(capacity);
+    }
+}
+
+template <typename Container>
+auto first_window(Container const &input, std::size_t window) {
+    if (window == 0) {
+        throw std::invalid_argument{"window must hold at least one value"};
+    }
+    auto last = std::cbegin(input);
+    auto count = std::size_t{0};
+    for (; count < window && last != std::cend(input); ++count) {
+        ++last;
+    }
+    return std::pair{last, count == window};
+}
+
+}
+
+namespace types {
+
+/**
+ * A function from bytes to values of the byte-sized type B given by a table with an entry per byte value, which
+ * fmap applies to the contiguous sequence containers of bytes via a vectorized table lookup.
+ */
+template <typename B>
+class lookup_table {
+    static_assert(detail::simd::is_byte_v<B>, "entries of a lookup_table must be byte-sized");
+
+  public:
+    explicit lookup_table(std::array<B, 256> const &entries) {
+        std::memcpy(table.data(), entries.data(), table.size());
+    }
+
+    /**
+     * Tabulates f: A -> B over every byte value.
+     */
+    template <typename A = B, typename UnaryFunction>
+    static lookup_table from(UnaryFunction const &f) {
+        auto tabulated = lookup_table{};
+        tabulated.table = detail::simd::tabulate<A>(f);
+        return tabulated;
+    }
+
+    template <typename A, typename = std::enable_if_t<detail::simd::is_byte_v<A>>>
+    B operator()(A value) const noexcept {
+        auto entry = B{};
+        std::memcpy(&entry, &table[static_cast<std::uint8_t>(value)], 1);
+        return entry;
+    }
+
+    detail::simd::byte_table const &bytes() const noexcept {
+        return table;
+    }
+
+  private:
+    lookup_table() = default;
+
+    detail::simd::byte_table table{};
+};
+
+}
+
+namespace detail {
+
+template <typename UnaryFunction>
+struct is_lookup_table : std::false_type {};
+
+template <typename B>
+struct is_lookup_table<types::lookup_table<B>> : std::true_type {};
+
+/**
+ * Tells whether mapping f: A -> B over a contiguous Container can be done by a table lookup, i.e. f is a lookup_table.
+ * Tabulating any other function is left to the caller, via lookup_table::from, since it calls the function on every
+ * byte value rather than only on the ones in the input.
+ */
+template <typename Container, typename A, typename B, typename UnaryFunction>
+inline constexpr bool is_byte_kernel_v = is_contiguous_v<Container> && simd::is_byte_v<A> && simd::is_byte_v<B> &&
+                                         is_lookup_table<UnaryFunction>::value;
+
 }
 
 template <template <typename...> typename SequenceContainer>
@@ -49,8 +190,43 @@ struct monad<SequenceContainer> {
     }
 
     template <typename A, typename = detail::enable_if_sequence_container<SequenceContainer>>
-    static constexpr auto wrap(A &&value) -> SequenceContainer<A> {
-        return SequenceContainer<A>{std::forward<A>(value)};
+    static constexpr auto wrap(A &&value) -> SequenceContainer<std::decay_t<A>> {
+        return wrap_in_place<std::decay_t<A>>(std::forward<A>(value));
+    }
+
+    /**
+     * Constructs the value directly inside the container, rather than copying it out of an std::initializer_list.
+     */
+    template <typename A, typename... Args>
+    static constexpr auto wrap_in_place(Args &&... args) -> SequenceContainer<A> {
+        static_assert(detail::holds_v<SequenceContainer, A>,
+                      "std::basic_string can only hold character types, so wrap into another sequence container");
+        auto singleton = SequenceContainer<A>{};
+        if constexpr (std::is_same_v<SequenceContainer<A>, std::basic_string<A>>) {
+            singleton.push_back(A(std::forward<Args>(args)...));
+        } else {
+            singleton.emplace_back(std::forward<Args>(args)...);
+        }
+        return singleton;
+    }
+
+    /**
+     * Fuses f: A -> SequenceContainer[B] and g: B -> SequenceContainer[C] into a single loop nest, where each
+     * intermediate value is moved into g and each inner result is moved into the output, instead of first collecting
+     * the values of every g(b) into an intermediate container.
+     */
+    template <typename UnaryFunctionA, typename UnaryFunctionB,
+              typename = detail::enable_if_sequence_container<SequenceContainer>>
+    static constexpr auto compose(UnaryFunctionA f, UnaryFunctionB g) {
+        return [f = std::move(f), g = std::move(g)](auto &&value) {
+            using namespace detail::ranges;
+            auto intermediate = f(std::forward<decltype(value)>(value));
+            auto mapped_sequence = decltype(g(std::move(*std::begin(intermediate)))){};
+            for (auto &e : intermediate) {
+                append(g(std::move(e)), mapped_sequence);
+            }
+            return mapped_sequence;
+        };
     }
 };
 
@@ -58,29 +234,292 @@ template <template <typename...> typename SequenceContainer>
 struct applicative<SequenceContainer> {
 
     template <typename A, typename B, typename BinaryFunction,
-              typename = detail::enable_if_sequence_container<SequenceContainer>>
+              typename = detail::enable_if_sequence_container<SequenceContainer>,
+              typename C = decltype(std::declval<BinaryFunction &>()(std::declval<A>(), std::declval<B>())),
+              typename = detail::enable_if_holds<SequenceContainer, C>>
     static constexpr auto combine(SequenceContainer<A> const &first, SequenceContainer<B> const &second,
-                                  BinaryFunction f)
-        -> SequenceContainer<decltype(f(std::declval<A>(), std::declval<B>()))> {
+                                  BinaryFunction f) -> SequenceContainer<C> {
         return detail::deriving::combine(first, second, f);
     }
 
+    /**
+     * Rejects combining std::basic_strings into values of a non-character type, e.g. via std::plus, which promotes
+     * characters to int.
+     */
+    template <typename A, typename B, typename BinaryFunction,
+              typename = detail::enable_if_sequence_container<SequenceContainer>,
+              typename C = decltype(std::declval<BinaryFunction &>()(std::declval<A>(), std::declval<B>())),
+              typename = detail::enable_if_not_holds<SequenceContainer, C>, typename = void>
+    static constexpr void combine(SequenceContainer<A> const &, SequenceContainer<B> const &, BinaryFunction) {
+        static_assert(detail::holds_v<SequenceContainer, C>,
+                      "std::basic_string can only hold character types, so combine into another sequence container");
+    }
+
     template <typename A, typename = detail::enable_if_sequence_container<SequenceContainer>>
-    static constexpr auto pure(A &&value) -> SequenceContainer<A> {
+    static constexpr auto pure(A &&value) -> SequenceContainer<std::decay_t<A>> {
         return detail::deriving::pure<SequenceContainer>(std::forward<A>(value));
     }
+
+    template <typename A, typename... Args>
+    static constexpr auto pure_in_place(Args &&... args) -> SequenceContainer<A> {
+        return detail::deriving::pure_in_place<SequenceContainer, A>(std::forward<Args>(args)...);
+    }
 };
 
 template <template <typename...> typename SequenceContainer>
 struct functor<SequenceContainer> {
 
-    template <typename A, typename UnaryFunction, typename = detail::enable_if_sequence_container<SequenceContainer>>
-    static constexpr auto fmap(SequenceContainer<A> const &input, UnaryFunction f)
-        -> SequenceContainer<decltype(f(std::declval<A>()))> {
-        return detail::deriving::fmap(input, f);
+    /**
+     * Maps each value straight into the output, rather than binding it to a singleton container.
+     *
+     * When f is a lookup_table, and the container is a contiguous one of bytes, f is instead applied via a vectorized
+     * table lookup.
+     */
+    template <typename A, typename UnaryFunction, typename = detail::enable_if_sequence_container<SequenceContainer>,
+              typename B = decltype(std::declval<UnaryFunction &>()(std::declval<A>())),
+              typename = detail::enable_if_holds<SequenceContainer, B>>
+    static constexpr auto fmap(SequenceContainer<A> const &input, UnaryFunction f) -> SequenceContainer<B> {
+        auto mapped = SequenceContainer<B>{};
+        if constexpr (detail::is_byte_kernel_v<SequenceContainer<A>, A, B, UnaryFunction>) {
+            detail::reserve(mapped, input.size());
+            detail::simd::lookup_chunks<B>(input.data(), input.size(), f.bytes(), [&mapped](auto first, auto last) {
+                mapped.insert(std::end(mapped), first, last);
+            });
+        } else {
+            detail::reserve(mapped, input.size());
+            std::transform(std::cbegin(input), std::cend(input), std::back_inserter(mapped), f);
+        }
+        return mapped;
+    }
+
+    /**
+     * Rejects mapping an std::basic_string into values of a non-character type.
+     */
+    template <typename A, typename UnaryFunction, typename = detail::enable_if_sequence_container<SequenceContainer>,
+              typename B = decltype(std::declval<UnaryFunction &>()(std::declval<A>())),
+              typename = detail::enable_if_not_holds<SequenceContainer, B>, typename = void>
+    static constexpr void fmap(SequenceContainer<A> const &, UnaryFunction) {
+        static_assert(detail::holds_v<SequenceContainer, B>,
+                      "std::basic_string can only hold character types, so fmap into another sequence container");
+    }
+};
+
+template <template <typename...> typename SequenceContainer>
+struct foldable<SequenceContainer> {
+
+    template <typename A, typename B, typename BinaryFunction,
+              typename = detail::enable_if_sequence_container<SequenceContainer>>
+    static constexpr auto fold(SequenceContainer<A> const &input, B init, BinaryFunction f) -> B {
+        for (auto const &e : input) {
+            init = f(std::move(init), e);
+        }
+        return init;
+    }
+};
+
+/**
+ * The comonad instance focuses on each suffix of a non-empty sequence: extract returns its first value and extend
+ * feeds every suffix into f as a non-owning view, which supports begin(), end(), size(), front(), and extract.
+ *
+ * Suffixes are the only neighbourhoods that the container alone determines at every position while obeying the
+ * comonad laws, as a window size isn't part of its type, so neighbourhoods of a fixed size are fed by extend_windowed
+ * instead. Building the views is O(n), but f mustn't keep them beyond the lifetime of input.
+ */
+template <template <typename...> typename SequenceContainer>
+struct comonad<SequenceContainer> {
+
+    /**
+     * @return the first value of input, which must be non-empty
+     */
+    template <typename A, typename = detail::enable_if_sequence_container<SequenceContainer>>
+    static constexpr auto extract(SequenceContainer<A> const &input) -> A const & {
+        return input.front();
+    }
+
+    template <typename A, typename UnaryFunction, typename = detail::enable_if_sequence_container<SequenceContainer>,
+              typename Suffix = detail::ranges::subrange<typename SequenceContainer<A>::const_iterator>>
+    static constexpr auto extend(SequenceContainer<A> const &input, UnaryFunction f)
+        -> SequenceContainer<decltype(f(std::declval<Suffix const &>()))> {
+        auto extended = SequenceContainer<decltype(f(std::declval<Suffix const &>()))>{};
+        detail::reserve(extended, input.size());
+        auto remaining = static_cast<std::size_t>(input.size());
+        for (auto suffix = std::cbegin(input); suffix != std::cend(input); ++suffix, --remaining) {
+            extended.push_back(f(Suffix{suffix, std::cend(input), remaining}));
+        }
+        return extended;
+    }
+};
+
+/**
+ * The comonad instance of the suffix views that comonad<SequenceContainer>::extend feeds into f, such that f can in
+ * turn extract from, or extend, a suffix. Since a view can't hold the results of extend, they're held by an
+ * std::vector instead.
+ */
+template <>
+struct comonad<detail::ranges::subrange> {
+
+    /**
+     * @return the first value of input, which must be non-empty
+     */
+    template <typename Iterator>
+    static constexpr decltype(auto) extract(detail::ranges::subrange<Iterator> const &input) {
+        return input.front();
+    }
+
+    template <typename Iterator, typename UnaryFunction>
+    static auto extend(detail::ranges::subrange<Iterator> const &input, UnaryFunction f)
+        -> std::vector<decltype(f(input))> {
+        auto extended = std::vector<decltype(f(input))>{};
+        extended.reserve(input.size());
+        auto remaining = input.size();
+        for (auto suffix = input.begin(); suffix != input.end(); ++suffix, --remaining) {
+            extended.push_back(f(detail::ranges::subrange<Iterator>{suffix, input.end(), remaining}));
+        }
+        return extended;
     }
 };
 
+namespace types {
+
+/**
+ * A monoid whose values all have an inverse, i.e. a group, such that combine(inverse(a), combine(a, b)) == b. E.g.
+ * addition with negation, multiplication of non-zero values with the reciprocal, or, as combine needn't be
+ * commutative, the composition of invertible functions.
+ */
+template <typename T, typename BinaryFunction, typename UnaryFunction>
+struct invertible_monoid {
+    T identity;
+    BinaryFunction combine;
+    UnaryFunction inverse;
+};
+
+template <typename T, typename BinaryFunction, typename UnaryFunction>
+invertible_monoid(T, BinaryFunction, UnaryFunction) -> invertible_monoid<T, BinaryFunction, UnaryFunction>;
+
+}
+
+/**
+ * Feeds every window of window consecutive values of input, from left to right, into f, as a non-owning view with
+ * begin(), end(), size() and front(), and then returns the results.
+ *
+ * @param input a sequence container of values of type A
+ * @param window the number of values in each window, which must be positive
+ * @param f a function that summarises the window into a value of type B
+ * @return a new sequence container with input.size() - window + 1 values of type B, or empty when input is shorter
+ * than window
+ */
+template <template <typename...> typename SequenceContainer, typename A, typename UnaryFunction,
+          typename = detail::enable_if_sequence_container<SequenceContainer>>
+auto extend_windowed(SequenceContainer<A> const &input, std::size_t window, UnaryFunction f) {
+    using Window = detail::ranges::subrange<typename SequenceContainer<A>::const_iterator>;
+    auto extended = SequenceContainer<decltype(f(std::declval<Window>()))>{};
+    auto [last, complete] = detail::first_window(input, window);
+    if (!complete) {
+        return extended;
+    }
+    detail::reserve(extended, input.size() - window + 1);
+    for (auto first = std::cbegin(input);; ++first, ++last) {
+        extended.push_back(f(Window{first, last, window}));
+        if (last == std::cend(input)) {
+            return extended;
+        }
+    }
+}
+
+/**
+ * Aggregates every window of window consecutive values of input, from left to right, with monoid, where each window
+ * is derived from the previous one by combining the inverse of the value that leaves it on the left, and the value
+ * that enters it on the right, so the values are always combined in the order of input.
+ *
+ * That's O(1) per window regardless of its size, and input is read in a single pass by two cursors that are window
+ * values apart, both moving forward, so large windows are streamed rather than read again.
+ *
+ * Note that, for floating-point values, the rounding errors accumulate along input instead of within each window.
+ *
+ * @param input a sequence container of values of type A
+ * @param window the number of values in each window, which must be positive
+ * @param monoid an invertible monoid over the values of type A
+ * @return a new sequence container with the aggregate of each of the input.size() - window + 1 windows, or empty when
+ * input is shorter than window
+ */
+template <template <typename...> typename SequenceContainer, typename A, typename T, typename BinaryFunction,
+          typename UnaryFunction, typename = detail::enable_if_sequence_container<SequenceContainer>>
+auto extend_windowed(SequenceContainer<A> const &input, std::size_t window,
+                     types::invertible_monoid<T, BinaryFunction, UnaryFunction> const &monoid) -> SequenceContainer<T> {
+    auto extended = SequenceContainer<T>{};
+    auto [last, complete] = detail::first_window(input, window);
+    if (!complete) {
+        return extended;
+    }
+    detail::reserve(extended, input.size() - window + 1);
+    auto aggregate = monoid.identity;
+    for (auto e = std::cbegin(input); e != last; ++e) {
+        aggregate = monoid.combine(std::move(aggregate), *e);
+    }
+    extended.push_back(aggregate);
+    for (auto first = std::cbegin(input); last != std::cend(input); ++first, ++last) {
+        aggregate = monoid.combine(monoid.combine(monoid.inverse(*first), std::move(aggregate)), *last);
+        extended.push_back(aggregate);
+    }
+    return extended;
+}
+
+/**
+ * Feeds each value of input into f: A -> optional[B] and keeps only the values of type B held by the non-empty
+ * optionals, writing them directly into the output rather than wrapping each one into an inner container to bind.
+ *
+ * @param input a sequence container of values of type A
+ * @param f a function A -> optional[B] that maps a value, or returns an empty optional to discard it
+ * @return a new sequence container with the present values of type B, in order
+ */
+template <template <typename...> typename SequenceContainer, typename A, typename UnaryFunction,
+          typename = detail::enable_if_sequence_container<SequenceContainer>>
+auto filter_map(SequenceContainer<A> const &input, UnaryFunction f)
+    -> SequenceContainer<typename decltype(f(std::declval<A>()))::value_type> {
+    using B = typename decltype(f(std::declval<A>()))::value_type;
+    auto filtered = SequenceContainer<B>{};
+    if constexpr (detail::is_compactable_v<SequenceContainer<B>>) {
+        filtered.resize(input.size());
+        auto const kept = detail::ranges::compact(input, filtered.begin(), [&f](auto const &e, auto &out) {
+            auto const mapped = f(e);
+            out = mapped.value_or(B{});
+            return mapped.has_value();
+        });
+        filtered.resize(kept);
+    } else {
+        for (auto const &e : input) {
+            if (auto mapped = f(e); mapped.has_value()) {
+                filtered.push_back(std::move(*mapped));
+            }
+        }
+    }
+    return filtered;
+}
+
+/**
+ * Keeps only the values of input that satisfy predicate.
+ *
+ * @param input a sequence container of values of type A
+ * @param predicate a function A -> bool that tells whether a value is kept
+ * @return a new sequence container with the values of type A that satisfy predicate, in order
+ */
+template <template <typename...> typename SequenceContainer, typename A, typename Predicate,
+          typename = detail::enable_if_sequence_container<SequenceContainer>>
+auto filter(SequenceContainer<A> const &input, Predicate predicate) -> SequenceContainer<A> {
+    auto filtered = SequenceContainer<A>{};
+    if constexpr (detail::is_compactable_v<SequenceContainer<A>>) {
+        filtered.resize(input.size());
+        auto const kept = detail::ranges::compact(input, filtered.begin(), [&predicate](auto const &e, auto &out) {
+            out = e;
+            return static_cast<bool>(predicate(e));
+        });
+        filtered.resize(kept);
+    } else {
+        std::copy_if(std::cbegin(input), std::cend(input), std::back_inserter(filtered), predicate);
+    }
+    return filtered;
+}
+
 namespace traits {
 template <template <typename...> typename SequenceContainer>
 struct is_monad<SequenceContainer> : std::true_type {};
@@ -90,6 +529,12 @@ struct is_applicative<SequenceContainer> : std::true_type {};
 
 template <template <typename...> typename SequenceContainer>
 struct is_functor<SequenceContainer> : std::true_type {};
+
+template <template <typename...> typename SequenceContainer>
+struct is_foldable<SequenceContainer> : std::true_type {};
+
+template <template <typename...> typename SequenceContainer>
+struct is_comonad<SequenceContainer> : std::true_type {};
 }
 
 }
@@ -0,0 +1,248 @@
+#ifndef RVARAGO_KITTEN_SET_CONTAINER_H
+#define RVARAGO_KITTEN_SET_CONTAINER_H
+
+#include <cstddef>
+#include <iterator>
+#include <set>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+
+#include "kitten/applicative.h"
+#include "kitten/functor.h"
+#include "kitten/monad.h"
+
+namespace rvarago::kitten {
+
+namespace detail::sets {
+
+template <typename T, typename Compare, typename Allocator>
+void reserve(std::set<T, Compare, Allocator> &, std::size_t) noexcept {
+}
+
+template <typename T, typename Hash, typename KeyEqual, typename Allocator>
+void reserve(std::unordered_set<T, Hash, KeyEqual, Allocator> &set, std::size_t capacity) {
+    set.reserve(capacity);
+}
+
+/**
+ * Inserts the values of inner into output. An rvalue inner of the same type as output has its nodes moved into output
+ * rather than copied, and a duplicate value is left behind in inner, i.e. never reallocated.
+ */
+template <typename Set, typename Inner>
+void insert(Set &output, Inner &&inner) {
+    if constexpr (std::is_same_v<std::decay_t<Inner>, Set> && !std::is_lvalue_reference_v<Inner>) {
+        if (output.empty()) {
+            output.swap(inner);
+        } else {
+            output.merge(inner);
+        }
+    } else {
+        output.insert(std::cbegin(inner), std::cend(inner));
+    }
+}
+
+/**
+ * The combinators shared by the instances of std::set and std::unordered_set.
+ *
+ * Every combinator inserts its values straight into the output set, so that duplicates are dropped as soon as they are
+ * produced and the output never holds more than the distinct values.
+ */
+template <template <typename...> typename Set>
+struct instances {
+
+    template <typename A, typename UnaryFunction>
+    static auto bind(Set<A> const &input, UnaryFunction f) -> std::decay_t<decltype(f(std::declval<A>()))> {
+        auto mapped_set = std::decay_t<decltype(f(std::declval<A>()))>{};
+        reserve(mapped_set, input.size());
+        for (auto const &e : input) {
+            insert(mapped_set, f(e));
+        }
+        return mapped_set;
+    }
+
+    template <typename A, typename... Args>
+    static auto wrap_in_place(Args &&... args) -> Set<A> {
+        auto singleton = Set<A>{};
+        singleton.emplace(std::forward<Args>(args)...);
+        return singleton;
+    }
+
+    template <typename UnaryFunctionA, typename UnaryFunctionB>
+    static auto compose(UnaryFunctionA f, UnaryFunctionB g) {
+        return [f = std::move(f), g = std::move(g)](auto &&value) {
+            auto intermediate = f(std::forward<decltype(value)>(value));
+            auto mapped_set = std::decay_t<decltype(g(*std::cbegin(intermediate)))>{};
+            reserve(mapped_set, intermediate.size());
+            for (auto const &e : intermediate) {
+                insert(mapped_set, g(e));
+            }
+            return mapped_set;
+        };
+    }
+
+    template <typename A, typename B, typename BinaryFunction>
+    static auto combine(Set<A> const &first, Set<B> const &second, BinaryFunction f)
+        -> Set<decltype(f(std::declval<A>(), std::declval<B>()))> {
+        auto combined = Set<decltype(f(std::declval<A>(), std::declval<B>()))>{};
+        reserve(combined, first.size());
+        for (auto const &a : first) {
+            for (auto const &b : second) {
+                combined.insert(f(a, b));
+            }
+        }
+        return combined;
+    }
+
+    template <typename A, typename UnaryFunction>
+    static auto fmap(Set<A> const &input, UnaryFunction f) -> Set<decltype(f(std::declval<A>()))> {
+        auto mapped = Set<decltype(f(std::declval<A>()))>{};
+        reserve(mapped, input.size());
+        for (auto const &e : input) {
+            mapped.insert(f(e));
+        }
+        return mapped;
+    }
+};
+
+}
+
+/**
+ * The monad instance of sets binds each value to an inner set and inserts its values into the output as they come,
+ * moving the nodes of the inner set when f returns it by value. Hence, the output holds the distinct values only,
+ * rather than every value returned by f before deduplicating them.
+ */
+template <>
+struct monad<std::set> {
+
+    template <typename A, typename UnaryFunction>
+    static auto bind(std::set<A> const &input, UnaryFunction f) -> std::decay_t<decltype(f(std::declval<A>()))> {
+        return detail::sets::instances<std::set>::bind(input, f);
+    }
+
+    template <typename A>
+    static auto wrap(A &&value) -> std::set<std::decay_t<A>> {
+        return wrap_in_place<std::decay_t<A>>(std::forward<A>(value));
+    }
+
+    template <typename A, typename... Args>
+    static auto wrap_in_place(Args &&... args) -> std::set<A> {
+        return detail::sets::instances<std::set>::wrap_in_place<A>(std::forward<Args>(args)...);
+    }
+
+    template <typename UnaryFunctionA, typename UnaryFunctionB>
+    static auto compose(UnaryFunctionA f, UnaryFunctionB g) {
+        return detail::sets::instances<std::set>::compose(std::move(f), std::move(g));
+    }
+};
+
+template <>
+struct applicative<std::set> {
+
+    template <typename A, typename B, typename BinaryFunction>
+    static auto combine(std::set<A> const &first, std::set<B> const &second, BinaryFunction f)
+        -> std::set<decltype(f(std::declval<A>(), std::declval<B>()))> {
+        return detail::sets::instances<std::set>::combine(first, second, f);
+    }
+
+    template <typename A>
+    static auto pure(A &&value) -> std::set<std::decay_t<A>> {
+        return monad<std::set>::wrap(std::forward<A>(value));
+    }
+
+    template <typename A, typename... Args>
+    static auto pure_in_place(Args &&... args) -> std::set<A> {
+        return monad<std::set>::wrap_in_place<A>(std::forward<Args>(args)...);
+    }
+};
+
+template <>
+struct functor<std::set> {
+
+    template <typename A, typename UnaryFunction>
+    static auto fmap(std::set<A> const &input, UnaryFunction f) -> std::set<decltype(f(std::declval<A>()))> {
+        return detail::sets::instances<std::set>::fmap(input, f);
+    }
+};
+
+/**
+ * As for std::set, and the output of bind reserves a bucket per input value up front.
+ */
+template <>
+struct monad<std::unordered_set> {
+
+    template <typename A, typename UnaryFunction>
+    static auto bind(std::unordered_set<A> const &input, UnaryFunction f)
+        -> std::decay_t<decltype(f(std::declval<A>()))> {
+        return detail::sets::instances<std::unordered_set>::bind(input, f);
+    }
+
+    template <typename A>
+    static auto wrap(A &&value) -> std::unordered_set<std::decay_t<A>> {
+        return wrap_in_place<std::decay_t<A>>(std::forward<A>(value));
+    }
+
+    template <typename A, typename... Args>
+    static auto wrap_in_place(Args &&... args) -> std::unordered_set<A> {
+        return detail::sets::instances<std::unordered_set>::wrap_in_place<A>(std::forward<Args>(args)...);
+    }
+
+    template <typename UnaryFunctionA, typename UnaryFunctionB>
+    static auto compose(UnaryFunctionA f, UnaryFunctionB g) {
+        return detail::sets::instances<std::unordered_set>::compose(std::move(f), std::move(g));
+    }
+};
+
+template <>
+struct applicative<std::unordered_set> {
+
+    template <typename A, typename B, typename BinaryFunction>
+    static auto combine(std::unordered_set<A> const &first, std::unordered_set<B> const &second, BinaryFunction f)
+        -> std::unordered_set<decltype(f(std::declval<A>(), std::declval<B>()))> {
+        return detail::sets::instances<std::unordered_set>::combine(first, second, f);
+    }
+
+    template <typename A>
+    static auto pure(A &&value) -> std::unordered_set<std::decay_t<A>> {
+        return monad<std::unordered_set>::wrap(std::forward<A>(value));
+    }
+
+    template <typename A, typename... Args>
+    static auto pure_in_place(Args &&... args) -> std::unordered_set<A> {
+        return monad<std::unordered_set>::wrap_in_place<A>(std::forward<Args>(args)...);
+    }
+};
+
+template <>
+struct functor<std::unordered_set> {
+
+    template <typename A, typename UnaryFunction>
+    static auto fmap(std::unordered_set<A> const &input, UnaryFunction f)
+        -> std::unordered_set<decltype(f(std::declval<A>()))> {
+        return detail::sets::instances<std::unordered_set>::fmap(input, f);
+    }
+};
+
+namespace traits {
+template <>
+struct is_monad<std::set> : std::true_type {};
+
+template <>
+struct is_applicative<std::set> : std::true_type {};
+
+template <>
+struct is_functor<std::set> : std::true_type {};
+
+template <>
+struct is_monad<std::unordered_set> : std::true_type {};
+
+template <>
+struct is_applicative<std::unordered_set> : std::true_type {};
+
+template <>
+struct is_functor<std::unordered_set> : std::true_type {};
+}
+
+}
+
+#endif
@@ -0,0 +1,397 @@
+#ifndef RVARAGO_KITTEN_SPILLED_SEQUENCE_H
+#define RVARAGO_KITTEN_SPILLED_SEQUENCE_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "kitten/foldable.h"
+#include "kitten/functor.h"
+#include "kitten/monad.h"
+
+#include "kitten/instances/mapped_array.h"
+#include "kitten/instances/sequence_container.h"
+
+#include "kitten/detail/deriving/from_monad/derive_kleisli.h"
+
+namespace rvarago::kitten {
+
+namespace detail::spill {
+
+inline std::string temporary_directory() {
+    if (auto const *directory = std::getenv("TMPDIR"); directory != nullptr && *directory != '\0') {
+        return directory;
+    }
+    return "/tmp";
+}
+
+/**
+ * An anonymous temporary file, unlinked as soon as it's created, so that it's removed once closed, even if the
+ * process crashes.
+ */
+class file {
+    int fd{-1};
+
+  public:
+    explicit file(std::string const &directory) {
+        auto path = directory + "/kitten_spill_XXXXXX";
+        fd = ::mkstemp(path.data());
+        if (fd < 0) {
+            posix::throw_last_error("mkstemp");
+        }
+        ::unlink(path.c_str());
+    }
+
+    file(file &&other) noexcept : fd{std::exchange(other.fd, -1)} {
+    }
+
+    file &operator=(file &&other) noexcept {
+        if (this != &other) {
+            close();
+            fd = std::exchange(other.fd, -1);
+        }
+        return *this;
+    }
+
+    file(file const &) = delete;
+    file &operator=(file const &) = delete;
+
+    ~file() {
+        close();
+    }
+
+    void append(void const *data, std::size_t bytes) const {
+        auto const *first = static_cast<char const *>(data);
+        while (bytes > 0) {
+            auto const written = ::write(fd, first, bytes);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                posix::throw_last_error("write");
+            }
+            first += written;
+            bytes -= static_cast<std::size_t>(written);
+        }
+    }
+
+    void read_at(std::size_t offset, void *data, std::size_t bytes) const {
+        auto *first = static_cast<char *>(data);
+        while (bytes > 0) {
+            auto const read = ::pread(fd, first, bytes, static_cast<off_t>(offset));
+            if (read <= 0) {
+                if (read < 0 && errno == EINTR) {
+                    continue;
+                }
+                posix::throw_last_error("pread");
+            }
+            first += read;
+            offset += static_cast<std::size_t>(read);
+            bytes -= static_cast<std::size_t>(read);
+        }
+    }
+
+  private:
+    void close() noexcept {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+};
+
+}
+
+namespace types {
+
+/**
+ * An append-only sequence of trivially-copyable records that keeps at most memory_budget bytes of them in memory, and
+ * writes the older ones to an anonymous temporary file whenever the budget would be exceeded (POSIX only).
+ *
+ * Its records are consumed by streaming them back in chunks of at most memory_budget bytes, and the combinators
+ * produce new spilled_sequences with the same budget, so a chain of them never holds the whole data in memory. Note
+ * that fmap and bind hold both a chunk of their input and the records of their output that are yet to be spilled, i.e.
+ * up to twice memory_budget.
+ */
+template <typename T>
+class spilled_sequence {
+    static_assert(std::is_trivially_copyable_v<T>, "records of a spilled_sequence must be trivially copyable");
+
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    /**
+     * The memory budget of the spilled_sequences created by wrap.
+     */
+    static constexpr size_type default_memory_budget = 16 * 1024 * 1024;
+
+    explicit spilled_sequence(size_type memory_budget, std::string directory = detail::spill::temporary_directory())
+        : budget{memory_budget}, location{std::move(directory)} {
+    }
+
+    /**
+     * Leaves other empty and still usable, with the same budget and directory, which is thus copied.
+     */
+    spilled_sequence(spilled_sequence &&other)
+        : budget{other.budget}, location{other.location}, storage{std::move(other.storage)},
+          tail{std::move(other.tail)}, spilled{std::exchange(other.spilled, 0)} {
+        other.storage.reset();
+        other.tail.clear();
+    }
+
+    spilled_sequence &operator=(spilled_sequence &&other) {
+        if (this != &other) {
+            budget = other.budget;
+            location = other.location;
+            storage = std::move(other.storage);
+            other.storage.reset();
+            tail = std::move(other.tail);
+            other.tail.clear();
+            spilled = std::exchange(other.spilled, 0);
+        }
+        return *this;
+    }
+
+    spilled_sequence(spilled_sequence const &) = delete;
+    spilled_sequence &operator=(spilled_sequence const &) = delete;
+
+    size_type size() const noexcept {
+        return spilled + tail.size();
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    /**
+     * The number of records written to disk so far.
+     */
+    size_type spilled_size() const noexcept {
+        return spilled;
+    }
+
+    size_type memory_budget() const noexcept {
+        return budget;
+    }
+
+    std::string const &directory() const noexcept {
+        return location;
+    }
+
+    /**
+     * Appends value, after spilling the records kept in memory if value wouldn't fit in the budget along with them.
+     */
+    void push_back(T const &value) {
+        make_room();
+        tail.push_back(value);
+    }
+
+    /**
+     * Constructs a record from args directly at the end, after spilling as push_back does.
+     */
+    template <typename... Args>
+    void emplace_back(Args &&... args) {
+        make_room();
+        tail.emplace_back(std::forward<Args>(args)...);
+    }
+
+    /**
+     * Feeds the records into f as consecutive [begin, end) chunks, in order, reading the spilled ones back from disk
+     * into a buffer of at most memory_budget bytes.
+     */
+    template <typename ChunkFunction>
+    void for_each_chunk(ChunkFunction f) const {
+        if (spilled > 0) {
+            auto buffer = std::vector<T>(std::min(records_per_chunk(), spilled));
+            for (size_type first = 0; first < spilled; first += buffer.size()) {
+                auto const count = std::min(buffer.size(), spilled - first);
+                storage->read_at(first * sizeof(T), buffer.data(), count * sizeof(T));
+                f(buffer.data(), buffer.data() + count);
+            }
+        }
+        if (!tail.empty()) {
+            f(tail.data(), tail.data() + tail.size());
+        }
+    }
+
+  private:
+    size_type records_per_chunk() const noexcept {
+        return std::max<size_type>(1, budget / sizeof(T));
+    }
+
+    /**
+     * Makes room for one more record in memory: spills the records kept so far if they fill the budget, or else grows
+     * them geometrically up to the budget, so that short sequences don't allocate the whole budget upfront.
+     */
+    void make_room() {
+        if (tail.size() == records_per_chunk()) {
+            spill();
+        }
+        if (tail.size() == tail.capacity()) {
+            tail.reserve(std::min(records_per_chunk(), std::max<size_type>(1, tail.capacity() * 2)));
+        }
+    }
+
+    void spill() {
+        if (!storage.has_value()) {
+            storage.emplace(location);
+        }
+        storage->append(tail.data(), tail.size() * sizeof(T));
+        spilled += tail.size();
+        tail.clear();
+    }
+
+    size_type budget;
+    std::string location;
+    std::optional<detail::spill::file> storage;
+    std::vector<T> tail;
+    size_type spilled{0};
+};
+
+}
+
+namespace detail::spill {
+
+/**
+ * Feeds each value of a spilled_sequence, streamed back in chunks, into f.
+ */
+template <typename T, typename UnaryFunction>
+void for_each_value(types::spilled_sequence<T> const &values, UnaryFunction f) {
+    values.for_each_chunk([&f](auto first, auto last) { std::for_each(first, last, f); });
+}
+
+/**
+ * Feeds each value of a range, e.g. a sequence container, into f.
+ */
+template <typename Range, typename UnaryFunction>
+void for_each_value(Range const &values, UnaryFunction f) {
+    for (auto const &value : values) {
+        f(value);
+    }
+}
+
+}
+
+/**
+ * Binds input to f like bind does, but keeps at most memory_budget bytes of the output in memory and spills the rest
+ * to a temporary file, such that a fan-out larger than the available memory still completes.
+ *
+ * @param input a sequence container of values of type A
+ * @param f a function A -> SequenceContainer[B], where B is trivially copyable
+ * @param memory_budget the number of bytes of records of type B kept in memory
+ * @param directory the directory where the temporary file is created, by default $TMPDIR or /tmp
+ * @return a spilled sequence with the values of type B returned by f, in order
+ */
+template <template <typename...> typename SequenceContainer, typename A, typename UnaryFunction,
+          typename = detail::enable_if_sequence_container<SequenceContainer>>
+auto bind_with_budget(SequenceContainer<A> const &input, UnaryFunction f, std::size_t memory_budget,
+                      std::string directory = detail::spill::temporary_directory())
+    -> types::spilled_sequence<typename decltype(f(std::declval<A>()))::value_type> {
+    using B = typename decltype(f(std::declval<A>()))::value_type;
+    auto mapped_sequence = types::spilled_sequence<B>{memory_budget, std::move(directory)};
+    for (auto const &e : input) {
+        for (auto const &mapped : f(e)) {
+            mapped_sequence.push_back(mapped);
+        }
+    }
+    return mapped_sequence;
+}
+
+/**
+ * The instances stream the records of a spilled_sequence and produce new spilled_sequences with the same memory budget
+ * and directory.
+ */
+template <>
+struct functor<types::spilled_sequence> {
+
+    template <typename A, typename UnaryFunction>
+    static auto fmap(types::spilled_sequence<A> const &input, UnaryFunction f)
+        -> types::spilled_sequence<decltype(f(std::declval<A>()))> {
+        auto mapped =
+            types::spilled_sequence<decltype(f(std::declval<A>()))>{input.memory_budget(), input.directory()};
+        input.for_each_chunk([&mapped, &f](auto first, auto last) {
+            for (; first != last; ++first) {
+                mapped.push_back(f(*first));
+            }
+        });
+        return mapped;
+    }
+};
+
+/**
+ * The monad instance binds to a function that returns either a spilled_sequence or a sequence container, and wrap
+ * creates a spilled_sequence with the default memory budget.
+ */
+template <>
+struct monad<types::spilled_sequence> {
+
+    template <typename A, typename UnaryFunction>
+    static auto bind(types::spilled_sequence<A> const &input, UnaryFunction f)
+        -> types::spilled_sequence<typename decltype(f(std::declval<A>()))::value_type> {
+        auto mapped_sequence = types::spilled_sequence<typename decltype(f(std::declval<A>()))::value_type>{
+            input.memory_budget(), input.directory()};
+        input.for_each_chunk([&mapped_sequence, &f](auto first, auto last) {
+            for (; first != last; ++first) {
+                detail::spill::for_each_value(f(*first), [&mapped_sequence](auto const &mapped) {
+                    mapped_sequence.push_back(mapped);
+                });
+            }
+        });
+        return mapped_sequence;
+    }
+
+    template <typename A>
+    static auto wrap(A &&value) -> types::spilled_sequence<std::decay_t<A>> {
+        return wrap_in_place<std::decay_t<A>>(std::forward<A>(value));
+    }
+
+    template <typename A, typename... Args>
+    static auto wrap_in_place(Args &&... args) -> types::spilled_sequence<A> {
+        auto singleton = types::spilled_sequence<A>{types::spilled_sequence<A>::default_memory_budget};
+        singleton.emplace_back(std::forward<Args>(args)...);
+        return singleton;
+    }
+
+    template <typename UnaryFunctionA, typename UnaryFunctionB>
+    static auto compose(UnaryFunctionA f, UnaryFunctionB g) {
+        return detail::deriving::compose<types::spilled_sequence>(std::move(f), std::move(g));
+    }
+};
+
+template <>
+struct foldable<types::spilled_sequence> {
+
+    template <typename A, typename B, typename BinaryFunction>
+    static auto fold(types::spilled_sequence<A> const &input, B init, BinaryFunction f) -> B {
+        input.for_each_chunk([&init, &f](auto first, auto last) {
+            for (; first != last; ++first) {
+                init = f(std::move(init), *first);
+            }
+        });
+        return init;
+    }
+};
+
+namespace traits {
+template <>
+struct is_functor<types::spilled_sequence> : std::true_type {};
+
+template <>
+struct is_monad<types::spilled_sequence> : std::true_type {};
+
+template <>
+struct is_foldable<types::spilled_sequence> : std::true_type {};
+}
+
+}
+
+#endif
@@ -0,0 +1,209 @@
+#ifndef RVARAGO_KITTEN_STATE_H
+#define RVARAGO_KITTEN_STATE_H
+
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "kitten/applicative.h"
+#include "kitten/functor.h"
+#include "kitten/monad.h"
+
+#include "kitten/instances/function.h"
+
+#include "kitten/detail/deriving/from_monad/derive_kleisli.h"
+
+namespace rvarago::kitten {
+
+namespace types {
+
+/**
+ * A computation that threads a state of type S while yielding a value of type A, wrapping a function S&& -> (A, S).
+ *
+ * The state is passed along by rvalue, such that each step may update it in place and move it into the next step,
+ * hence a state of type S is never copied, unless a step does so itself, e.g. get_state. Since the wrapped function is
+ * a concrete function object rather than a type-erased one, a chain of combinators is a single nested function object
+ * that the compiler can inline into a single function.
+ */
+template <typename Function>
+class state {
+    function_wrapper<Function> transition;
+
+  public:
+    explicit constexpr state(Function f) : transition{std::move(f)} {
+    }
+
+    /**
+     * Feeds the state s into the computation, moving it along the way.
+     */
+    template <typename S>
+    constexpr auto operator()(S &&s) const -> decltype(transition(std::move(s))) {
+        static_assert(!std::is_lvalue_reference_v<S>, "the state must be passed by rvalue, e.g. via std::move");
+        return transition(std::move(s));
+    }
+
+    /**
+     * @return the pair of the value yielded by the computation and the final state
+     */
+    template <typename S>
+    constexpr auto run(S initial) const {
+        return (*this)(std::move(initial));
+    }
+
+    /**
+     * @return the value yielded by the computation
+     */
+    template <typename S>
+    constexpr auto eval(S initial) const {
+        return std::move(run(std::move(initial)).first);
+    }
+
+    /**
+     * @return the final state
+     */
+    template <typename S>
+    constexpr S exec(S initial) const {
+        return std::move(run(std::move(initial)).second);
+    }
+};
+
+/**
+ * @return a state computation that wraps f: S&& -> (A, S)
+ */
+template <typename Function>
+constexpr state<Function> make_state(Function f) {
+    return state<Function>{std::move(f)};
+}
+
+/**
+ * @return a state computation that yields a copy of the state
+ */
+constexpr auto get_state() {
+    return make_state([](auto &&s) {
+        using S = std::decay_t<decltype(s)>;
+        return std::pair<S, S>{s, std::move(s)};
+    });
+}
+
+/**
+ * @return a state computation that yields the value selected by f: S const& -> A, without copying the state
+ */
+template <typename UnaryFunction>
+constexpr auto select_state(UnaryFunction f) {
+    return make_state([f = std::move(f)](auto &&s) {
+        auto selected = f(std::as_const(s));
+        return std::pair{std::move(selected), std::move(s)};
+    });
+}
+
+/**
+ * @return a state computation that replaces the state with value
+ */
+template <typename S>
+constexpr auto put_state(S value) {
+    return make_state([value = std::move(value)](auto &&) { return std::pair{std::monostate{}, value}; });
+}
+
+/**
+ * @return a state computation that updates the state in place via f: S& -> void
+ */
+template <typename UnaryFunction>
+constexpr auto modify_state(UnaryFunction f) {
+    return make_state([f = std::move(f)](auto &&s) {
+        f(s);
+        return std::pair{std::monostate{}, std::move(s)};
+    });
+}
+
+}
+
+/**
+ * The instances compose state computations into a new one that moves the state from each step into the next, rather
+ * than copying it.
+ */
+template <>
+struct functor<types::state> {
+
+    template <typename Function, typename UnaryFunction>
+    static constexpr auto fmap(types::state<Function> const &input, UnaryFunction f) {
+        return types::make_state([input, f = std::move(f)](auto &&s) {
+            auto [value, next] = input(std::move(s));
+            return std::pair{f(std::move(value)), std::move(next)};
+        });
+    }
+};
+
+template <>
+struct applicative<types::state> {
+
+    template <typename FunctionA, typename FunctionB, typename BinaryFunction>
+    static constexpr auto combine(types::state<FunctionA> const &first, types::state<FunctionB> const &second,
+                                  BinaryFunction f) {
+        return types::make_state([first, second, f = std::move(f)](auto &&s) {
+            auto [first_value, intermediate] = first(std::move(s));
+            auto [second_value, next] = second(std::move(intermediate));
+            return std::pair{f(std::move(first_value), std::move(second_value)), std::move(next)};
+        });
+    }
+
+    template <typename A>
+    static constexpr auto pure(A &&value) {
+        return types::make_state(
+            [value = std::decay_t<A>(std::forward<A>(value))](auto &&s) { return std::pair{value, std::move(s)}; });
+    }
+
+    /**
+     * Constructs the value straight into the capture of the computation, rather than moving a temporary into it.
+     */
+    template <typename A, typename... Args>
+    static constexpr auto pure_in_place(Args &&... args) {
+        return types::make_state(
+            [value = A(std::forward<Args>(args)...)](auto &&s) { return std::pair{value, std::move(s)}; });
+    }
+};
+
+template <>
+struct monad<types::state> {
+
+    /**
+     * Runs input, and then the computation returned by f: A -> state[B] for its value, with the state moved from
+     * input.
+     */
+    template <typename Function, typename UnaryFunction>
+    static constexpr auto bind(types::state<Function> const &input, UnaryFunction f) {
+        return types::make_state([input, f = std::move(f)](auto &&s) {
+            auto [value, next] = input(std::move(s));
+            return f(std::move(value))(std::move(next));
+        });
+    }
+
+    template <typename A>
+    static constexpr auto wrap(A &&value) {
+        return applicative<types::state>::pure(std::forward<A>(value));
+    }
+
+    template <typename A, typename... Args>
+    static constexpr auto wrap_in_place(Args &&... args) {
+        return applicative<types::state>::pure_in_place<A>(std::forward<Args>(args)...);
+    }
+
+    template <typename UnaryFunctionA, typename UnaryFunctionB>
+    static constexpr auto compose(UnaryFunctionA f, UnaryFunctionB g) {
+        return detail::deriving::compose<types::state>(std::move(f), std::move(g));
+    }
+};
+
+namespace traits {
+template <>
+struct is_functor<types::state> : std::true_type {};
+
+template <>
+struct is_applicative<types::state> : std::true_type {};
+
+template <>
+struct is_monad<types::state> : std::true_type {};
+}
+
+}
+
+#endif
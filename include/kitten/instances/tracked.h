@@ -0,0 +1,260 @@
+#ifndef RVARAGO_KITTEN_TRACKED_H
+#define RVARAGO_KITTEN_TRACKED_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace rvarago::kitten {
+
+namespace detail::bits {
+
+using word_type = std::uint64_t;
+
+inline constexpr std::size_t bits_per_word = 64;
+
+constexpr std::size_t words_for(std::size_t size) noexcept {
+    return (size + bits_per_word - 1) / bits_per_word;
+}
+
+inline std::size_t lowest_set_bit(word_type word) noexcept {
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_ctzll(word));
+#else
+    auto position = std::size_t{0};
+    for (; (word & word_type{1}) == 0; word >>= 1) {
+        ++position;
+    }
+    return position;
+#endif
+}
+
+/**
+ * Feeds the position of each set bit of word, offset by base, into f, from the lowest to the highest.
+ */
+template <typename UnaryFunction>
+void for_each_set_bit(word_type word, std::size_t base, UnaryFunction &f) {
+    for (; word != 0; word &= word - 1) {
+        f(base + lowest_set_bit(word));
+    }
+}
+
+}
+
+namespace types {
+
+template <typename Container>
+class tracked;
+
+/**
+ * A vector that records which of its values were modified since the last call to clear_dirty(), such that the values
+ * derived from it can be patched by recomputing only the modified positions, e.g. via fmap_incremental.
+ *
+ * Modified positions are kept in a bitmap with one bit per value, which is itself summarised by a bitmap with one bit
+ * per word, so visiting and clearing the modified positions skips the unmodified chunks of 4096 values at once.
+ */
+template <typename T, typename Allocator>
+class tracked<std::vector<T, Allocator>> {
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    tracked() = default;
+
+    explicit tracked(std::vector<T, Allocator> initial) {
+        assign(std::move(initial));
+    }
+
+    size_type size() const noexcept {
+        return data.size();
+    }
+
+    bool empty() const noexcept {
+        return data.empty();
+    }
+
+    T const &operator[](size_type i) const noexcept {
+        return data[i];
+    }
+
+    std::vector<T, Allocator> const &values() const noexcept {
+        return data;
+    }
+
+    /**
+     * Replaces the i-th value and marks it as modified.
+     */
+    void set(size_type i, T value) {
+        data[i] = std::move(value);
+        mark(i);
+    }
+
+    /**
+     * Modifies the i-th value in place via f: T& -> void and marks it as modified.
+     */
+    template <typename UnaryFunction>
+    void update(size_type i, UnaryFunction f) {
+        f(data[i]);
+        mark(i);
+    }
+
+    /**
+     * Replaces every value, which marks the whole vector as modified.
+     */
+    void assign(std::vector<T, Allocator> values) {
+        data = std::move(values);
+        dirty.assign(detail::bits::words_for(data.size()), 0);
+        summary.assign(detail::bits::words_for(dirty.size()), 0);
+        dirty_values = 0;
+        stale = true;
+    }
+
+    bool is_dirty(size_type i) const noexcept {
+        return stale || ((dirty[i / detail::bits::bits_per_word] >> (i % detail::bits::bits_per_word)) & 1) != 0;
+    }
+
+    /**
+     * @return the number of values modified since the last call to clear_dirty()
+     */
+    size_type dirty_count() const noexcept {
+        return stale ? data.size() : dirty_values;
+    }
+
+    /**
+     * Feeds the position of each value modified since the last call to clear_dirty() into f, in increasing order.
+     */
+    template <typename UnaryFunction>
+    void for_each_dirty(UnaryFunction f) const {
+        if (stale) {
+            for (size_type i = 0; i < data.size(); ++i) {
+                f(i);
+            }
+            return;
+        }
+        for (size_type s = 0; s < summary.size(); ++s) {
+            auto visit_word = [this, &f](size_type w) {
+                detail::bits::for_each_set_bit(dirty[w], w * detail::bits::bits_per_word, f);
+            };
+            detail::bits::for_each_set_bit(summary[s], s * detail::bits::bits_per_word, visit_word);
+        }
+    }
+
+    /**
+     * Marks every value as unmodified, in time proportional to the number of modified chunks.
+     */
+    void clear_dirty() noexcept {
+        for (size_type s = 0; s < summary.size(); ++s) {
+            auto clear_word = [this](size_type w) { dirty[w] = 0; };
+            detail::bits::for_each_set_bit(summary[s], s * detail::bits::bits_per_word, clear_word);
+            summary[s] = 0;
+        }
+        dirty_values = 0;
+        stale = false;
+    }
+
+  private:
+    void mark(size_type i) noexcept {
+        auto const w = i / detail::bits::bits_per_word;
+        auto const bit = detail::bits::word_type{1} << (i % detail::bits::bits_per_word);
+        if ((dirty[w] & bit) == 0) {
+            dirty[w] |= bit;
+            summary[w / detail::bits::bits_per_word] |= detail::bits::word_type{1} << (w % detail::bits::bits_per_word);
+            ++dirty_values;
+        }
+    }
+
+    std::vector<T, Allocator> data;
+    std::vector<detail::bits::word_type> dirty;
+    std::vector<detail::bits::word_type> summary;
+    size_type dirty_values{0};
+    bool stale{true};
+};
+
+}
+
+/**
+ * The ratio of modified values above which the incremental combinators recompute the whole output, since a full
+ * sequential pass then costs less than patching scattered positions.
+ */
+inline constexpr double default_full_recompute_ratio = 0.25;
+
+/**
+ * Brings output up to date with fmap(input.values(), f), given that output held that result before the values
+ * currently marked as modified in input were changed: only the modified positions are fed into f: A -> B and
+ * overwritten in output, unless output doesn't match the size of input or too many values were modified, in which
+ * case the whole output is recomputed.
+ *
+ * Modified positions are left marked, so that several outputs can be patched from the same input before calling
+ * input.clear_dirty().
+ *
+ * @param input a tracked vector of values of type A
+ * @param f a function A -> B, expected to be pure
+ * @param output the vector of values of type B previously computed from input, patched in place
+ * @param full_recompute_ratio the ratio of modified values above which the whole output is recomputed
+ */
+template <typename A, typename AllocatorA, typename UnaryFunction, typename B, typename AllocatorB>
+void fmap_incremental(types::tracked<std::vector<A, AllocatorA>> const &input, UnaryFunction f,
+                      std::vector<B, AllocatorB> &output, double full_recompute_ratio = default_full_recompute_ratio) {
+    if (output.size() != input.size() ||
+        static_cast<double>(input.dirty_count()) > full_recompute_ratio * static_cast<double>(input.size())) {
+        output.clear();
+        output.reserve(input.size());
+        std::transform(input.values().cbegin(), input.values().cend(), std::back_inserter(output), f);
+        return;
+    }
+    input.for_each_dirty([&](std::size_t i) { output[i] = f(input[i]); });
+}
+
+/**
+ * Brings output up to date with combine(first.values(), second.values(), f), i.e. f applied to every pair of values
+ * laid out row by row, given that output held that result before the values currently marked as modified in first
+ * and second were changed: only the rows of the modified values of first and the columns of the modified values of
+ * second are recomputed, unless output doesn't match the sizes of the inputs or too many values were modified, in
+ * which case the whole output is recomputed.
+ *
+ * @param first a tracked vector of values of type A
+ * @param second a tracked vector of values of type B
+ * @param f a function (A, B) -> C, expected to be pure
+ * @param output the vector of values of type C previously computed from first and second, patched in place
+ * @param full_recompute_ratio the ratio of recomputed values above which the whole output is recomputed
+ */
+template <typename A, typename AllocatorA, typename B, typename AllocatorB, typename BinaryFunction, typename C,
+          typename AllocatorC>
+void combine_incremental(types::tracked<std::vector<A, AllocatorA>> const &first,
+                         types::tracked<std::vector<B, AllocatorB>> const &second, BinaryFunction f,
+                         std::vector<C, AllocatorC> &output,
+                         double full_recompute_ratio = default_full_recompute_ratio) {
+    auto const rows = first.size();
+    auto const columns = second.size();
+    auto const patched = first.dirty_count() * columns + second.dirty_count() * rows;
+    if (output.size() != rows * columns ||
+        static_cast<double>(patched) > full_recompute_ratio * static_cast<double>(output.size())) {
+        output.clear();
+        output.reserve(rows * columns);
+        for (auto const &a : first.values()) {
+            for (auto const &b : second.values()) {
+                output.push_back(f(a, b));
+            }
+        }
+        return;
+    }
+    first.for_each_dirty([&](std::size_t i) {
+        for (std::size_t j = 0; j < columns; ++j) {
+            output[i * columns + j] = f(first[i], second[j]);
+        }
+    });
+    second.for_each_dirty([&](std::size_t j) {
+        for (std::size_t i = 0; i < rows; ++i) {
+            if (!first.is_dirty(i)) {
+                output[i * columns + j] = f(first[i], second[j]);
+            }
+        }
+    });
+}
+
+}
+
+#endif
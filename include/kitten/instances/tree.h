@@ -0,0 +1,303 @@
+#ifndef RVARAGO_KITTEN_TREE_H
+#define RVARAGO_KITTEN_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "kitten/foldable.h"
+#include "kitten/functor.h"
+#include "kitten/monad.h"
+
+#include "kitten/detail/concurrency/fork_join.h"
+#include "kitten/detail/deriving/from_monad/derive_kleisli.h"
+
+namespace rvarago::kitten {
+
+namespace types {
+
+/**
+ * An n-ary (rose) tree whose nodes are laid out contiguously in preorder: the values in one vector, and the shape,
+ * i.e. the size of the subtree rooted at each node, in another. The children of a node follow it, each one after the
+ * whole subtree of its previous sibling.
+ *
+ * The shape is immutable and shared between trees, so mapping the values reuses it as is.
+ */
+template <typename T>
+class tree {
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    /**
+     * An empty tree, without even a root.
+     */
+    tree() : shape{std::make_shared<std::vector<size_type> const>()} {
+    }
+
+    /**
+     * A tree rooted at value with children, whose nodes are copied into it, such that nesting this constructor copies a
+     * node once per ancestor. Hence, deep trees are rather built in a single pass via from_preorder.
+     */
+    explicit tree(T value, std::vector<tree> children = {}) {
+        auto size = size_type{1};
+        for (auto const &child : children) {
+            size += child.size();
+        }
+        auto sizes = std::vector<size_type>{};
+        sizes.reserve(size);
+        nodes.reserve(size);
+        sizes.push_back(size);
+        nodes.push_back(std::move(value));
+        for (auto &child : children) {
+            sizes.insert(sizes.end(), child.shape->cbegin(), child.shape->cend());
+            std::move(child.nodes.begin(), child.nodes.end(), std::back_inserter(nodes));
+        }
+        shape = std::make_shared<std::vector<size_type> const>(std::move(sizes));
+    }
+
+    /**
+     * Builds a tree in a single pass from the value and the size of the subtree of each node, both in preorder.
+     *
+     * @throws std::invalid_argument if there isn't a size per value, or the sizes don't describe a single tree
+     */
+    static tree from_preorder(std::vector<T> values, std::vector<size_type> subtree_sizes) {
+        if (values.size() != subtree_sizes.size()) {
+            throw std::invalid_argument{"tree must have a subtree size per value"};
+        }
+        if (!values.empty() && subtree_sizes.front() != values.size()) {
+            throw std::invalid_argument{"tree must have a single root"};
+        }
+        auto ends = std::vector<size_type>{};
+        for (size_type node = 0; node < subtree_sizes.size(); ++node) {
+            while (!ends.empty() && ends.back() <= node) {
+                ends.pop_back();
+            }
+            auto const end = node + subtree_sizes[node];
+            if (subtree_sizes[node] == 0 || (!ends.empty() && end > ends.back())) {
+                throw std::invalid_argument{"tree must have every subtree nested within its parent"};
+            }
+            ends.push_back(end);
+        }
+        return tree{std::move(values), std::make_shared<std::vector<size_type> const>(std::move(subtree_sizes))};
+    }
+
+    size_type size() const noexcept {
+        return nodes.size();
+    }
+
+    bool empty() const noexcept {
+        return nodes.empty();
+    }
+
+    T const &root() const noexcept {
+        return nodes.front();
+    }
+
+    /**
+     * @return the values of every node, in preorder
+     */
+    std::vector<T> const &values() const noexcept {
+        return nodes;
+    }
+
+    /**
+     * @return the number of nodes of the subtree rooted at node, including node itself
+     */
+    size_type subtree_size(size_type node) const noexcept {
+        return (*shape)[node];
+    }
+
+    /**
+     * Feeds the position of each child of node into f, from the first to the last.
+     */
+    template <typename UnaryFunction>
+    void for_each_child(size_type node, UnaryFunction f) const {
+        auto const last = node + subtree_size(node);
+        for (auto child = node + 1; child < last; child += subtree_size(child)) {
+            f(child);
+        }
+    }
+
+    /**
+     * @return a copy of the subtree rooted at node
+     */
+    tree subtree(size_type node) const {
+        auto const last = node + subtree_size(node);
+        return tree{std::vector<T>(nodes.cbegin() + node, nodes.cbegin() + last),
+                    std::make_shared<std::vector<size_type> const>(shape->cbegin() + node, shape->cbegin() + last)};
+    }
+
+    /**
+     * @return a tree with the same shape as this tree, which is shared rather than copied, and with values in preorder
+     * @throws std::invalid_argument if there isn't a value per node
+     */
+    template <typename U>
+    tree<U> with_values(std::vector<U> values) const {
+        if (values.size() != size()) {
+            throw std::invalid_argument{"tree must have a value per node"};
+        }
+        return tree<U>{std::move(values), shape};
+    }
+
+    /**
+     * @return whether other has the same shape as this tree, regardless of its values
+     */
+    template <typename U>
+    bool same_shape(tree<U> const &other) const noexcept {
+        return shape == other.shape || *shape == *other.shape;
+    }
+
+    friend bool operator==(tree const &first, tree const &second) {
+        return first.same_shape(second) && first.nodes == second.nodes;
+    }
+
+    friend bool operator!=(tree const &first, tree const &second) {
+        return !(first == second);
+    }
+
+  private:
+    template <typename U>
+    friend class tree;
+
+    friend struct monad<tree>;
+
+    tree(std::vector<T> values, std::shared_ptr<std::vector<size_type> const> sizes)
+        : nodes{std::move(values)}, shape{std::move(sizes)} {
+    }
+
+    std::vector<T> nodes;
+    std::shared_ptr<std::vector<size_type> const> shape;
+};
+
+/**
+ * Maps every value of input via f like fmap does, but splits the nodes among threads that map their share
+ * concurrently, which pays off for trees with millions of nodes.
+ *
+ * @param input a tree of values of type A
+ * @param f a function A -> B, where B is default-constructible, that's safe to call concurrently
+ * @param threads the number of threads, by default the number of concurrent threads supported by the machine
+ * @return a new tree with the same shape as input and the values of type B mapped by f
+ */
+template <typename A, typename UnaryFunction>
+auto fmap_parallel(tree<A> const &input, UnaryFunction f,
+                   std::size_t threads = detail::concurrency::default_threads()) {
+    using B = decltype(f(std::declval<A>()));
+    static_assert(std::is_default_constructible_v<B>, "fmap_parallel requires a default-constructible result");
+    auto mapped = std::vector<B>(input.size());
+    threads = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(input.size(), 1));
+    detail::concurrency::fork_join(threads, [&](std::size_t t) {
+        auto const first = input.size() * t / threads;
+        auto const last = input.size() * (t + 1) / threads;
+        std::transform(input.values().cbegin() + first, input.values().cbegin() + last, mapped.begin() + first, f);
+    });
+    return input.with_values(std::move(mapped));
+}
+
+}
+
+/**
+ * The functor instance maps the values in a single sweep over the contiguous nodes, and shares the shape of input
+ * with the result.
+ */
+template <>
+struct functor<types::tree> {
+
+    template <typename A, typename UnaryFunction>
+    static auto fmap(types::tree<A> const &input, UnaryFunction f) -> types::tree<decltype(f(std::declval<A>()))> {
+        auto mapped = std::vector<decltype(f(std::declval<A>()))>{};
+        mapped.reserve(input.size());
+        std::transform(input.values().cbegin(), input.values().cend(), std::back_inserter(mapped), f);
+        return input.with_values(std::move(mapped));
+    }
+};
+
+/**
+ * The monad instance replaces each node with the non-empty tree that f returns for its value, whose children come
+ * before the ones of the node, as in Haskell's Data.Tree.
+ */
+template <>
+struct monad<types::tree> {
+
+    /**
+     * Grafts the tree that f returns for each node in preorder, which is also the order of the grafted trees in the
+     * result, and then sizes the root of each grafted tree to span the ones grafted for the descendants of its node.
+     */
+    template <typename A, typename UnaryFunction>
+    static auto bind(types::tree<A> const &input, UnaryFunction f) -> decltype(f(std::declval<A>())) {
+        using B = typename decltype(f(std::declval<A>()))::value_type;
+        auto values = std::vector<B>{};
+        auto sizes = std::vector<std::size_t>{};
+        auto roots = std::vector<std::size_t>{};
+        values.reserve(input.size());
+        sizes.reserve(input.size());
+        roots.reserve(input.size());
+        for (auto const &value : input.nodes) {
+            auto const grafted = f(value);
+            if (grafted.empty()) {
+                throw std::invalid_argument{"bind requires f to return a non-empty tree"};
+            }
+            roots.push_back(values.size());
+            values.insert(values.end(), grafted.nodes.cbegin(), grafted.nodes.cend());
+            sizes.insert(sizes.end(), grafted.shape->cbegin(), grafted.shape->cend());
+        }
+        for (std::size_t node = 0; node < input.size(); ++node) {
+            auto const last = node + input.subtree_size(node);
+            sizes[roots[node]] = (last < input.size() ? roots[last] : values.size()) - roots[node];
+        }
+        return {std::move(values), std::make_shared<std::vector<std::size_t> const>(std::move(sizes))};
+    }
+
+    template <typename A>
+    static auto wrap(A &&value) -> types::tree<std::decay_t<A>> {
+        return types::tree<std::decay_t<A>>{std::forward<A>(value)};
+    }
+
+    template <typename A, typename... Args>
+    static auto wrap_in_place(Args &&... args) -> types::tree<A> {
+        auto values = std::vector<A>{};
+        values.reserve(1);
+        values.emplace_back(std::forward<Args>(args)...);
+        return {std::move(values), std::make_shared<std::vector<std::size_t> const>(1, 1)};
+    }
+
+    template <typename UnaryFunctionA, typename UnaryFunctionB>
+    static auto compose(UnaryFunctionA f, UnaryFunctionB g) {
+        return detail::deriving::compose<types::tree>(std::move(f), std::move(g));
+    }
+};
+
+template <>
+struct foldable<types::tree> {
+
+    /**
+     * Folds the values in preorder.
+     */
+    template <typename A, typename B, typename BinaryFunction>
+    static auto fold(types::tree<A> const &input, B init, BinaryFunction f) -> B {
+        for (auto const &e : input.values()) {
+            init = f(std::move(init), e);
+        }
+        return init;
+    }
+};
+
+namespace traits {
+template <>
+struct is_functor<types::tree> : std::true_type {};
+
+template <>
+struct is_monad<types::tree> : std::true_type {};
+
+template <>
+struct is_foldable<types::tree> : std::true_type {};
+}
+
+}
+
+#endif
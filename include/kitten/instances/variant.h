@@ -1,7 +1,14 @@
 #ifndef RVARAGO_KITTEN_VARIANT_H
 #define RVARAGO_KITTEN_VARIANT_H
 
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <variant>
+#include <vector>
 
 #include "kitten/multifunctor.h"
 
@@ -35,6 +42,114 @@ template <>
 struct is_multifunctor<std::variant> : std::true_type {};
 }
 
+namespace detail {
+
+template <typename Variant>
+using variant_buckets = std::array<std::vector<std::pair<std::size_t, Variant const *>>, std::variant_size_v<Variant>>;
+
+/**
+ * Groups the positions of the variants by their index(), using the index to select the bucket rather than branching
+ * on it.
+ */
+template <typename Variant, typename Sequence>
+auto bucket_by_index(Sequence const &input) -> variant_buckets<Variant> {
+    auto buckets = variant_buckets<Variant>{};
+    auto position = std::size_t{0};
+    for (auto const &value : input) {
+        if (value.valueless_by_exception()) {
+            throw std::bad_variant_access{};
+        }
+        buckets[value.index()].emplace_back(position++, &value);
+    }
+    return buckets;
+}
+
+template <typename ResultT, typename Variant, typename UnaryFunction, std::size_t... Indices>
+auto multimap_at_index(Variant const &input, UnaryFunction &f, std::index_sequence<Indices...>) -> ResultT {
+    using Mapper = ResultT (*)(Variant const &, UnaryFunction &);
+    static constexpr Mapper mappers[] = {[](Variant const &value, UnaryFunction &g) {
+        return ResultT{std::in_place_index<Indices>, g(*std::get_if<Indices>(&value))};
+    }...};
+    if (input.valueless_by_exception()) {
+        throw std::bad_variant_access{};
+    }
+    return mappers[input.index()](input, f);
+}
+
+template <typename Buckets, typename BucketFunction, std::size_t... Indices>
+constexpr void for_each_bucket(Buckets const &buckets, BucketFunction f, std::index_sequence<Indices...>) {
+    (f(std::integral_constant<std::size_t, Indices>{}, std::get<Indices>(buckets)), ...);
+}
+
+}
+
+/**
+ * Applies multimap to every variant of the sequence, but instead of dispatching on the alternative of each variant,
+ * which is an unpredictable indirect branch per element, it first groups the variants by alternative and then runs
+ * a tight monomorphic loop over each group. The results are scattered back in the original order.
+ *
+ * Each value keeps the index of its alternative. The scattering requires the resulting variant to be default
+ * constructible, otherwise it falls back to mapping one variant at a time.
+ *
+ * @param input a sequence container of variants of A1, ..., Z1
+ * @param f a function A1, ..., Z1 -> A2, ..., Z2 that maps over the value wrapped inside each variant
+ * @return a new sequence container of variants of A2, ..., Z2 in the same order as input
+ */
+template <template <typename...> typename SequenceContainer, typename... Rest, typename UnaryFunction>
+auto batch_multimap(SequenceContainer<std::variant<Rest...>> const &input, UnaryFunction f)
+    -> SequenceContainer<std::variant<decltype(f(std::declval<Rest>()))...>> {
+    using InputT = std::variant<Rest...>;
+    using ResultT = std::variant<decltype(f(std::declval<Rest>()))...>;
+    auto mapped = std::vector<ResultT>{};
+    if constexpr (std::is_default_constructible_v<ResultT>) {
+        mapped.resize(std::size(input));
+        detail::for_each_bucket(
+            detail::bucket_by_index<InputT>(input),
+            [&mapped, &f](auto index, auto const &bucket) {
+                for (auto const &[position, value] : bucket) {
+                    mapped[position].template emplace<index()>(f(*std::get_if<index()>(value)));
+                }
+            },
+            std::index_sequence_for<Rest...>{});
+    } else {
+        mapped.reserve(std::size(input));
+        for (auto const &value : input) {
+            mapped.push_back(detail::multimap_at_index<ResultT>(value, f, std::index_sequence_for<Rest...>{}));
+        }
+    }
+    if constexpr (std::is_same_v<SequenceContainer<ResultT>, std::vector<ResultT>>) {
+        return mapped;
+    } else {
+        return SequenceContainer<ResultT>(std::make_move_iterator(mapped.begin()),
+                                          std::make_move_iterator(mapped.end()));
+    }
+}
+
+/**
+ * Same as batch_multimap, but leaves the results grouped by alternative rather than scattering them back.
+ *
+ * @param input a sequence container of variants of A1, ..., Z1
+ * @param f a function A1, ..., Z1 -> A2, ..., Z2 that maps over the value wrapped inside each variant
+ * @return a tuple with one vector per alternative A2, ..., Z2, each of them in the relative order of input
+ */
+template <template <typename...> typename SequenceContainer, typename... Rest, typename UnaryFunction>
+auto batch_multimap_grouped(SequenceContainer<std::variant<Rest...>> const &input, UnaryFunction f)
+    -> std::tuple<std::vector<decltype(f(std::declval<Rest>()))>...> {
+    using InputT = std::variant<Rest...>;
+    auto grouped = std::tuple<std::vector<decltype(f(std::declval<Rest>()))>...>{};
+    detail::for_each_bucket(
+        detail::bucket_by_index<InputT>(input),
+        [&grouped, &f](auto index, auto const &bucket) {
+            auto &group = std::get<index()>(grouped);
+            group.reserve(bucket.size());
+            for (auto const &entry : bucket) {
+                group.push_back(f(*std::get_if<index()>(entry.second)));
+            }
+        },
+        std::index_sequence_for<Rest...>{});
+    return grouped;
+}
+
 }
 
 #endif
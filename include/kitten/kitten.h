@@ -2,6 +2,8 @@
 #define RVARAGO_KITTEN_KITTEN_H
 
 #include "kitten/applicative.h"
+#include "kitten/comonad.h"
+#include "kitten/foldable.h"
 #include "kitten/functor.h"
 #include "kitten/monad.h"
 #include "kitten/multifunctor.h"
@@ -2,6 +2,7 @@
 #define RVARAGO_KITTEN_MONAD_H
 
 #include <type_traits>
+#include <utility>
 
 namespace rvarago::kitten {
 
@@ -44,6 +45,19 @@ constexpr decltype(auto) wrap(A &&value) {
     return monad<M>::wrap(std::forward<A>(value));
 }
 
+/**
+ * Lifts a value of type A, constructed in place from args, into a monad M[A], such that move-only or expensive to move
+ * values are never materialized outside of the monad.
+ *
+ * @param args the arguments forwarded to the constructor of A
+ * @return a new monad m: M[A] that wraps the value of type A constructed from args
+ */
+template <template <typename...> typename M, typename A, typename... Args>
+constexpr decltype(auto) wrap_in_place(Args &&... args) {
+    static_assert(traits::is_monad_v<M>, "type constructor M does not have a monad instance");
+    return monad<M>::template wrap_in_place<A>(std::forward<Args>(args)...);
+}
+
 /**
  * Unwraps the monad ma: M[A], feeds the unwrapped value of type A into the function f: A -> M[B], and then returns
  * its result.
@@ -53,8 +67,8 @@ constexpr decltype(auto) wrap(A &&value) {
  * @return a new monad mb: M[B] resulting from applying f over the unwrapped value from ma and then flattening the
  * result
  */
-template <template <typename...> typename M, typename A, typename UnaryFunction>
-constexpr decltype(auto) bind(M<A> const &input, UnaryFunction f) {
+template <template <typename...> typename M, typename A, typename... Rest, typename UnaryFunction>
+constexpr decltype(auto) bind(M<A, Rest...> const &input, UnaryFunction f) {
     static_assert(traits::is_monad_v<M>, "type constructor M does not have a monad instance");
     return monad<M>::bind(input, f);
 }
@@ -62,11 +76,28 @@ constexpr decltype(auto) bind(M<A> const &input, UnaryFunction f) {
 /**
  * Infix version of bind.
  */
-template <template <typename...> typename M, typename A, typename UnaryFunction>
-constexpr decltype(auto) operator>>(M<A> const &input, UnaryFunction f) {
+template <template <typename...> typename M, typename A, typename... Rest, typename UnaryFunction>
+constexpr decltype(auto) operator>>(M<A, Rest...> const &input, UnaryFunction f) {
     return bind(input, f);
 }
 
+/**
+ * Composes the monadic functions f: A -> M[B] and g: B -> M[C] into a single function h: A -> M[C] (also known as
+ * Kleisli composition, or >=>), such that h(a) == bind(f(a), g).
+ *
+ * The composition is built before any value flows through it, which allows the monad instance to fuse f and g, e.g.
+ * by moving the intermediate value of type B into g instead of copying it out of M[B].
+ *
+ * @param f a function A -> M[B] to be applied first
+ * @param g a function B -> M[C] to be applied with the values unwrapped from the result of f
+ * @return a function A -> M[C] that applies f and then binds its result to g
+ */
+template <template <typename...> typename M, typename UnaryFunctionA, typename UnaryFunctionB>
+constexpr decltype(auto) kleisli(UnaryFunctionA f, UnaryFunctionB g) {
+    static_assert(traits::is_monad_v<M>, "type constructor M does not have a monad instance");
+    return monad<M>::compose(std::move(f), std::move(g));
+}
+
 }
 
 #endif
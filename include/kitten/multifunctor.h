@@ -1,6 +1,8 @@
 #ifndef RVARAGO_KITTEN_MULTIFUNCTOR_H
 #define RVARAGO_KITTEN_MULTIFUNCTOR_H
 
+#include <type_traits>
+
 namespace rvarago::kitten {
 
 /**
@@ -0,0 +1,272 @@
+#ifndef RVARAGO_KITTEN_PIPELINE_H
+#define RVARAGO_KITTEN_PIPELINE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "kitten/detail/concurrency/spsc_channel.h"
+
+namespace rvarago::kitten {
+
+namespace detail::pipeline {
+
+template <typename UnaryFunction>
+struct fmap_stage {
+    UnaryFunction f;
+
+    template <typename A>
+    using output_t = std::decay_t<std::invoke_result_t<UnaryFunction const &, A const &>>;
+
+    template <typename A, typename Batch>
+    void operator()(A const &value, Batch &out) const {
+        out.push_back(f(value));
+    }
+};
+
+template <typename UnaryFunction>
+struct bind_stage {
+    UnaryFunction f;
+
+    template <typename A>
+    using output_t = typename std::decay_t<std::invoke_result_t<UnaryFunction const &, A const &>>::value_type;
+
+    template <typename A, typename Batch>
+    void operator()(A const &value, Batch &out) const {
+        for (auto &&e : f(value)) {
+            out.push_back(std::move(e));
+        }
+    }
+};
+
+template <typename A, typename... Stages>
+struct element_types {
+    using type = std::tuple<A>;
+};
+
+template <typename A, typename Stage, typename... Stages>
+struct element_types<A, Stage, Stages...> {
+    using type = decltype(std::tuple_cat(
+        std::declval<std::tuple<A>>(),
+        std::declval<typename element_types<typename Stage::template output_t<A>, Stages...>::type>()));
+};
+
+template <typename A, typename Stages>
+struct pipeline_elements;
+
+template <typename A, typename... Stages>
+struct pipeline_elements<A, std::tuple<Stages...>> : element_types<A, Stages...> {};
+
+template <typename Elements, std::size_t... Indices>
+auto make_channels(std::size_t capacity, std::index_sequence<Indices...>) {
+    return std::tuple<concurrency::spsc_channel<std::vector<std::tuple_element_t<Indices, Elements>>>...>{
+        ((void)Indices, capacity)...};
+}
+
+/**
+ * Shared state of a running pipeline, where the first failure raises cancelled to unblock every other thread.
+ */
+struct execution {
+    std::atomic<bool> cancelled{false};
+    std::vector<std::exception_ptr> errors;
+
+    explicit execution(std::size_t threads) : errors(threads) {
+    }
+
+    template <typename Body>
+    void guard(std::size_t thread, Body body) noexcept {
+        try {
+            body();
+        } catch (...) {
+            errors[thread] = std::current_exception();
+            cancelled.store(true);
+        }
+    }
+
+    void rethrow() const {
+        for (auto const &error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+};
+
+template <typename Input, typename A>
+void produce(Input const &input, concurrency::spsc_channel<std::vector<A>> &out, std::size_t batch_size,
+             execution &state) {
+    auto batch = std::vector<A>{};
+    batch.reserve(batch_size);
+    for (auto const &value : input) {
+        batch.push_back(value);
+        if (batch.size() == batch_size) {
+            if (!concurrency::send(out, batch, state.cancelled)) {
+                return;
+            }
+            batch = std::vector<A>{};
+            batch.reserve(batch_size);
+        }
+    }
+    if (!batch.empty()) {
+        concurrency::send(out, batch, state.cancelled);
+    }
+}
+
+template <typename Stage, typename A, typename B>
+void process(Stage const &stage, concurrency::spsc_channel<std::vector<A>> &in,
+             concurrency::spsc_channel<std::vector<B>> &out, std::size_t batch_size, execution &state) {
+    auto input_batch = std::vector<A>{};
+    auto output_batch = std::vector<B>{};
+    output_batch.reserve(batch_size);
+    while (concurrency::receive(in, input_batch, state.cancelled)) {
+        for (auto const &value : input_batch) {
+            stage(value, output_batch);
+            if (output_batch.size() >= batch_size) {
+                if (!concurrency::send(out, output_batch, state.cancelled)) {
+                    return;
+                }
+                output_batch = std::vector<B>{};
+                output_batch.reserve(batch_size);
+            }
+        }
+    }
+    if (!output_batch.empty()) {
+        concurrency::send(out, output_batch, state.cancelled);
+    }
+}
+
+template <template <typename...> typename SequenceContainer, typename Input, typename Stages, std::size_t... Indices>
+auto run(Input const &input, Stages const &stages, std::size_t batch_size, std::size_t capacity,
+         std::index_sequence<Indices...>) {
+    using Elements = typename pipeline_elements<typename Input::value_type, Stages>::type;
+    using Output = std::tuple_element_t<sizeof...(Indices), Elements>;
+    constexpr auto collector = sizeof...(Indices) + 1;
+
+    auto channels = make_channels<Elements>(capacity, std::make_index_sequence<sizeof...(Indices) + 1>{});
+    auto state = execution{collector + 1};
+    auto workers = std::vector<std::thread>{};
+    auto collected = SequenceContainer<Output>{};
+
+    state.guard(collector, [&] {
+        workers.reserve(collector);
+        workers.emplace_back([&] {
+            state.guard(0, [&] { produce(input, std::get<0>(channels), batch_size, state); });
+            std::get<0>(channels).close();
+        });
+        (workers.emplace_back([&] {
+            state.guard(Indices + 1, [&] {
+                process(std::get<Indices>(stages), std::get<Indices>(channels), std::get<Indices + 1>(channels),
+                        batch_size, state);
+            });
+            std::get<Indices + 1>(channels).close();
+        }),
+         ...);
+
+        auto batch = std::vector<Output>{};
+        while (concurrency::receive(std::get<collector - 1>(channels), batch, state.cancelled)) {
+            std::move(batch.begin(), batch.end(), std::back_inserter(collected));
+        }
+    });
+
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    state.rethrow();
+    return collected;
+}
+
+}
+
+namespace types {
+
+template <typename Input, typename Stages>
+class pipeline;
+
+/**
+ * A chain of fmap (|) and bind (>>) stages over a sequence, where each stage runs on its own thread as soon as the
+ * previous one produces a batch, such that the throughput approaches the one of the slowest stage rather than the sum
+ * of all stages.
+ *
+ * Stages communicate via bounded lock-free single-producer/single-consumer channels of batches, so a fast stage
+ * blocks once it's too far ahead of the next one. The input is only referenced and must outlive collect(), so a
+ * pipeline can't be started from a temporary. An idle stage backs off from spinning to sleeping.
+ *
+ * Note that, as with the infix operators of the other combinators, >> binds tighter than |, so a bind stage that
+ * follows a fmap stage requires parentheses, e.g. (pipelined(xs) | parse) >> expand | score.
+ */
+template <typename Input, typename... Stages>
+class pipeline<Input, std::tuple<Stages...>> {
+    Input const &input;
+    std::tuple<Stages...> stages;
+    std::size_t batch_size;
+    std::size_t capacity;
+
+  public:
+    pipeline(Input const &source, std::tuple<Stages...> chain, std::size_t batch, std::size_t channel_capacity)
+        : input{source}, stages{std::move(chain)}, batch_size{std::max<std::size_t>(batch, 1)},
+          capacity{channel_capacity} {
+    }
+
+    pipeline(Input const &&, std::tuple<Stages...>, std::size_t, std::size_t) = delete;
+
+    template <typename UnaryFunction>
+    auto operator|(UnaryFunction f) && {
+        return std::move(*this).then(detail::pipeline::fmap_stage<UnaryFunction>{std::move(f)});
+    }
+
+    template <typename UnaryFunction>
+    auto operator>>(UnaryFunction f) && {
+        return std::move(*this).then(detail::pipeline::bind_stage<UnaryFunction>{std::move(f)});
+    }
+
+    /**
+     * Runs every stage concurrently and collects the output of the last one into a sequence container.
+     *
+     * If any stage throws, the whole pipeline is cancelled and the exception is rethrown here.
+     */
+    template <template <typename...> typename SequenceContainer = std::vector>
+    auto collect() const {
+        return detail::pipeline::run<SequenceContainer>(input, stages, batch_size, capacity,
+                                                        std::index_sequence_for<Stages...>{});
+    }
+
+  private:
+    template <typename Stage>
+    auto then(Stage stage) && -> pipeline<Input, std::tuple<Stages..., Stage>> {
+        return {input, std::tuple_cat(std::move(stages), std::tuple<Stage>{std::move(stage)}), batch_size, capacity};
+    }
+};
+
+}
+
+/**
+ * Starts a pipelined chain of stages over input.
+ *
+ * @param input a sequence whose elements feed the first stage
+ * @param batch_size the number of elements sent at once between two stages
+ * @param capacity the number of batches that a channel between two stages holds before blocking its producer
+ * @return a pipeline without stages yet, to be extended with | (fmap) and >> (bind) and then collected
+ */
+template <typename Input>
+auto pipelined(Input const &input, std::size_t batch_size = 256, std::size_t capacity = 16)
+    -> types::pipeline<Input, std::tuple<>> {
+    return {input, std::tuple<>{}, batch_size, capacity};
+}
+
+/**
+ * A pipeline only references its input, which would dangle if it were a temporary.
+ */
+template <typename Input>
+auto pipelined(Input const &&input, std::size_t batch_size = 256, std::size_t capacity = 16)
+    -> types::pipeline<Input, std::tuple<>> = delete;
+
+}
+
+#endif
@@ -0,0 +1,105 @@
+#include <cstdlib>
+#include <new>
+
+#include "utils.h"
+
+namespace {
+
+thread_local rvarago::kitten::test::utils::allocations counted;
+
+void *allocate(std::size_t bytes) {
+    ++counted.count;
+    counted.bytes += bytes;
+    return std::malloc(bytes == 0 ? 1 : bytes);
+}
+
+void *allocate(std::size_t bytes, std::align_val_t alignment) {
+    ++counted.count;
+    counted.bytes += bytes;
+    auto const align = static_cast<std::size_t>(alignment);
+#if defined(_MSC_VER)
+    return _aligned_malloc(bytes == 0 ? 1 : bytes, align);
+#else
+    return std::aligned_alloc(align, bytes == 0 ? align : (bytes + align - 1) / align * align);
+#endif
+}
+
+void deallocate(void *p, std::align_val_t) noexcept {
+#if defined(_MSC_VER)
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+}
+
+namespace rvarago::kitten::test::utils {
+
+allocations thread_allocations() noexcept {
+    return counted;
+}
+
+}
+
+void *operator new(std::size_t bytes) {
+    if (auto *p = allocate(bytes)) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void *operator new[](std::size_t bytes) {
+    return operator new(bytes);
+}
+
+void *operator new(std::size_t bytes, std::nothrow_t const &) noexcept {
+    return allocate(bytes);
+}
+
+void *operator new[](std::size_t bytes, std::nothrow_t const &) noexcept {
+    return allocate(bytes);
+}
+
+void *operator new(std::size_t bytes, std::align_val_t alignment) {
+    if (auto *p = allocate(bytes, alignment)) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void *operator new[](std::size_t bytes, std::align_val_t alignment) {
+    return operator new(bytes, alignment);
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::align_val_t alignment) noexcept {
+    deallocate(p, alignment);
+}
+
+void operator delete[](void *p, std::align_val_t alignment) noexcept {
+    deallocate(p, alignment);
+}
+
+void operator delete(void *p, std::size_t, std::align_val_t alignment) noexcept {
+    deallocate(p, alignment);
+}
+
+void operator delete[](void *p, std::size_t, std::align_val_t alignment) noexcept {
+    deallocate(p, alignment);
+}
@@ -0,0 +1,278 @@
+#include <catch2/catch.hpp>
+
+#include <deque>
+#include <functional>
+#include <kitten/instances/chunked_vector.h>
+#include <kitten/instances/function.h>
+#include <kitten/instances/nullable_column.h>
+#include <kitten/instances/optional.h>
+#include <kitten/instances/persistent_vector.h>
+#include <kitten/instances/sequence_container.h>
+#include <kitten/instances/tracked.h>
+#include <kitten/instances/variant.h>
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "utils.h"
+
+namespace {
+
+using namespace rvarago::kitten;
+using test::utils::count_allocations;
+using test::utils::filling_allocations;
+using test::utils::growth_allocations;
+
+auto const twice = [](int v) { return v * 2; };
+auto const sum = [](int a, int b) { return a + b; };
+
+SCENARIO("combinators make a fixed number of allocations", "[allocations]") {
+
+    GIVEN("std::optional") {
+
+        auto const some = std::optional<int>{1};
+        auto result = std::optional<int>{};
+
+        THEN("fmap, combine, wrap, and bind never allocate") {
+
+            CHECK(count_allocations([&] { result = some | twice; }).count == 0);
+            CHECK(count_allocations([&] { result = some + some; }).count == 0);
+            CHECK(count_allocations([&] { result = wrap<std::optional>(1); }).count == 0);
+            CHECK(count_allocations([&] { result = some >> [](int v) { return std::optional{v}; }; }).count == 0);
+        }
+    }
+
+    GIVEN("std::variant") {
+
+        auto const choice = std::variant<int, std::string>{1};
+        auto result = std::variant<long, std::string>{};
+
+        THEN("multimap never allocates") {
+
+            auto mapper =
+                syntax::overloaded{[](int v) { return static_cast<long>(v); }, [](std::string v) { return v; }};
+
+            CHECK(count_allocations([&] { result = choice || mapper; }).count == 0);
+        }
+    }
+
+    GIVEN("types::function_wrapper") {
+
+        auto result = 0;
+
+        THEN("composition and invocation never allocate") {
+
+            CHECK(count_allocations([&] { result = (types::fn(twice) | types::fn(twice))(1); }).count == 0);
+        }
+    }
+
+    GIVEN("std::vector") {
+
+        constexpr auto n = std::size_t{100};
+        constexpr auto m = std::size_t{10};
+
+        auto const first = std::vector<int>(n, 1);
+        auto const second = std::vector<int>(m, 1);
+        auto result = std::vector<int>{};
+
+        THEN("wrap allocates once") {
+
+            CHECK(count_allocations([&] { result = wrap<std::vector>(1); }).count == 1);
+        }
+
+        THEN("fmap allocates once") {
+
+            CHECK(count_allocations([&] { result = first | twice; }).count == 1);
+        }
+
+        THEN("bind allocates the inner results plus the growth of the output") {
+
+            auto duplicate_value = [](int v) { return std::vector<int>{v, v}; };
+
+            CHECK(count_allocations([&] { result = first >> duplicate_value; }).count ==
+                  n + growth_allocations<std::vector<int>>(2 * n));
+        }
+
+        THEN("combine allocates a singleton and an inner row per pair plus the growth of the output") {
+
+            CHECK(count_allocations([&] { result = first + second; }).count ==
+                  n * (m + growth_allocations<std::vector<int>>(m)) + growth_allocations<std::vector<int>>(n * m));
+        }
+
+        THEN("filter allocates once") {
+
+            CHECK(count_allocations([&] { result = filter(first, [](int v) { return v > 0; }); }).count == 1);
+        }
+    }
+
+    GIVEN("std::deque") {
+
+        using deque = std::deque<int>;
+
+        constexpr auto n = std::size_t{100};
+        constexpr auto m = std::size_t{10};
+
+        auto const first = deque(n, 1);
+        auto const second = deque(m, 1);
+        auto result = deque{};
+
+        THEN("wrap and fmap allocate as much as filling the output") {
+
+            CHECK(count_allocations([&] { result = wrap<std::deque>(1); }).count == filling_allocations<deque>(1));
+            CHECK(count_allocations([&] { result = first | twice; }).count == filling_allocations<deque>(n));
+        }
+
+        THEN("bind allocates the inner results plus the output") {
+
+            auto duplicate_value = [](int v) { return deque{v, v}; };
+            auto const per_inner = count_allocations([&] { auto const inner = duplicate_value(1); }).count;
+
+            CHECK(count_allocations([&] { result = first >> duplicate_value; }).count ==
+                  n * per_inner + filling_allocations<deque>(2 * n));
+        }
+
+        THEN("combine allocates a singleton and an inner row per pair plus the output") {
+
+            CHECK(count_allocations([&] { result = first + second; }).count ==
+                  n * (m * filling_allocations<deque>(1) + filling_allocations<deque>(m)) +
+                      filling_allocations<deque>(n * m));
+        }
+
+        THEN("filter allocates a single output sized for every value") {
+
+            auto const sized = count_allocations([&] {
+                                   auto output = deque{};
+                                   output.resize(n);
+                               }).count;
+
+            CHECK(count_allocations([&] { result = filter(first, [](int v) { return v > 0; }); }).count == sized);
+        }
+    }
+
+    GIVEN("std::list") {
+
+        using list = std::list<int>;
+
+        constexpr auto n = std::size_t{100};
+        constexpr auto m = std::size_t{10};
+
+        auto const first = list(n, 1);
+        auto const second = list(m, 1);
+        auto result = list{};
+
+        THEN("wrap, fmap, and filter allocate a node per output value") {
+
+            CHECK(count_allocations([&] { result = wrap<std::list>(1); }).count == 1);
+            CHECK(count_allocations([&] { result = first | twice; }).count == n);
+            CHECK(count_allocations([&] { result = filter(first, [](int v) { return v > 0; }); }).count == n);
+        }
+
+        THEN("bind allocates the nodes of the inner results plus the nodes of the output") {
+
+            auto duplicate_value = [](int v) { return list{v, v}; };
+
+            CHECK(count_allocations([&] { result = first >> duplicate_value; }).count == 2 * n + 2 * n);
+        }
+
+        THEN("combine allocates a singleton and a row node per pair plus the nodes of the output") {
+
+            CHECK(count_allocations([&] { result = first + second; }).count == n * (m + m) + n * m);
+        }
+    }
+
+    GIVEN("types::nullable_column") {
+
+        auto const column = types::nullable_column<int>{std::vector<std::optional<int>>(100, 1)};
+        auto result = types::nullable_column<int>{};
+
+        THEN("fmap and combine allocate the values and the validity bitmap once each") {
+
+            CHECK(count_allocations([&] { result = column | twice; }).count == 2);
+            CHECK(count_allocations([&] { result = column + column; }).count == 2);
+        }
+    }
+
+    GIVEN("types::chunked_vector") {
+
+        using chunk_list = std::vector<std::shared_ptr<std::vector<int>>>;
+
+        constexpr auto n = 2 * types::chunked_vector<int>::chunk_size;
+
+        auto const chunked = types::chunked_vector<int>(std::vector<int>(n, 1));
+        auto result = types::chunked_vector<int>{};
+
+        THEN("fmap allocates each chunk of the output plus the growth of its list of chunks") {
+
+            CHECK(count_allocations([&] { result = chunked | twice; }).count ==
+                  2 * 2 + growth_allocations<chunk_list>(2));
+        }
+
+        THEN("bind allocates the inner results and merges them into full chunks") {
+
+            auto singleton = [](int v) { return types::chunked_vector<int>{v}; };
+            auto const per_singleton = count_allocations([&] { result = singleton(1); }).count;
+
+            auto doublings = std::size_t{0};
+            for (std::size_t capacity = 1; capacity < types::chunked_vector<int>::chunk_size; capacity *= 2) {
+                ++doublings;
+            }
+
+            // The chunk of the first inner result is moved rather than allocated, and then doubles until it's full,
+            // whereas the second chunk, along with its storage, is allocated in full at once.
+            CHECK(count_allocations([&] { result = chunked >> singleton; }).count ==
+                  n * per_singleton + doublings + 2 + growth_allocations<chunk_list>(2) - 1);
+            CHECK(result.chunk_count() == 2);
+        }
+    }
+
+    GIVEN("types::persistent_vector") {
+
+        auto const persistent = types::persistent_vector<int>{1, 2, 3};
+        auto result = types::persistent_vector<int>{};
+
+        THEN("set copies the path to the updated value") {
+
+            CHECK(count_allocations([&] { result = persistent.set(0, 2); }).count == 2);
+        }
+
+        THEN("wrap allocates a single leaf") {
+
+            CHECK(count_allocations([&] { result = wrap<types::persistent_vector>(1); }).count == 2);
+        }
+
+        THEN("fmap allocates once per node") {
+
+            CHECK(count_allocations([&] { result = persistent | twice; }).count == 2);
+        }
+    }
+
+    GIVEN("types::tracked") {
+
+        auto prices = types::tracked<std::vector<int>>{std::vector<int>(1000, 1)};
+        auto resource = test::utils::counting_resource{};
+        auto repriced = std::pmr::vector<int>{&resource};
+
+        fmap_incremental(prices, twice, repriced);
+        prices.clear_dirty();
+
+        THEN("the full recompute allocates the output once") {
+
+            CHECK(resource.allocated().count == 1);
+            CHECK(resource.allocated().bytes == 1000 * sizeof(int));
+        }
+
+        THEN("patching never allocates") {
+
+            prices.set(10, 2);
+
+            CHECK(count_allocations([&] { fmap_incremental(prices, twice, repriced); }).count == 0);
+            CHECK(resource.allocated().count == 1);
+        }
+    }
+}
+
+}
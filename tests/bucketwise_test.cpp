@@ -0,0 +1,88 @@
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <kitten/bucketwise.h>
+#include <kitten/instances/set_container.h>
+#include <list>
+#include <set>
+#include <unordered_set>
+
+#include "utils.h"
+
+namespace {
+
+using namespace rvarago::kitten;
+using test::utils::is_same_after_decaying;
+
+auto const halve = [](int v) { return v / 2; };
+
+auto const around = [](int v) { return std::unordered_set<int>{v - 1, v + 1}; };
+
+std::unordered_set<int> iota_set(int size) {
+    auto values = std::unordered_set<int>{};
+    for (int i = 0; i < size; ++i) {
+        values.insert(i);
+    }
+    return values;
+}
+
+SCENARIO("the bucketwise traversal agrees with fmap and bind", "[bucketwise]") {
+
+    GIVEN("a std::unordered_set") {
+
+        WHEN("it's empty") {
+
+            auto const values = std::unordered_set<int>{};
+
+            THEN("yield the empty results") {
+
+                CHECK(fmap_bucketwise(values, halve).empty());
+                CHECK(bind_bucketwise(values, around).empty());
+            }
+        }
+
+        WHEN("it spans one or many buckets") {
+
+            THEN("yield the same sets as fmap and bind") {
+
+                for (auto const size : {1, 5, 100, 10000}) {
+
+                    auto const values = iota_set(size);
+                    auto const mapped = fmap_bucketwise(values, halve);
+                    auto const bound = bind_bucketwise(values, around);
+
+                    static_assert(is_same_after_decaying<decltype(mapped), std::unordered_set<int>>);
+                    static_assert(is_same_after_decaying<decltype(bound), std::unordered_set<int>>);
+
+                    CHECK(mapped == fmap(values, halve));
+                    CHECK(bound == bind(values, around));
+                }
+            }
+
+            THEN("feed every value into f once") {
+
+                auto const values = iota_set(1000);
+                auto visits = std::size_t{0};
+                auto const mapped = fmap_bucketwise(values, [&visits](int v) {
+                    ++visits;
+                    return v;
+                });
+
+                CHECK(visits == values.size());
+                CHECK(mapped == values);
+            }
+        }
+    }
+
+    GIVEN("containers that are a single chain of nodes") {
+
+        THEN("have no buckets to walk") {
+
+            static_assert(detail::ranges::has_buckets_v<std::unordered_set<int>>);
+            static_assert(!detail::ranges::has_buckets_v<std::set<int>>);
+            static_assert(!detail::ranges::has_buckets_v<std::list<int>>);
+        }
+    }
+}
+
+}
@@ -0,0 +1,229 @@
+#include <catch2/catch.hpp>
+
+#include <kitten/instances/chunked_vector.h>
+#include <string>
+#include <vector>
+
+#include "utils.h"
+
+namespace {
+
+using namespace std::string_literals;
+
+using namespace rvarago::kitten;
+using test::utils::is_same_after_decaying;
+using types::chunked_vector;
+
+SCENARIO("chunked_vector admits functor, applicative, and monad instances", "[chunked_vector]") {
+
+    GIVEN("A chunked_vector") {
+
+        AND_GIVEN("flatten") {
+
+            WHEN("spanning several chunks") {
+
+                auto values = std::vector<int>{};
+                auto chunked = chunked_vector<int>{};
+                for (int i = 0; i < 3 * static_cast<int>(chunked_vector<int>::chunk_size) + 1; ++i) {
+                    values.push_back(i);
+                    chunked.push_back(i);
+                }
+
+                THEN("return a contiguous std::vector with the same elements in order") {
+
+                    CHECK(chunked.chunk_count() == 4);
+                    CHECK(chunked.flatten() == values);
+
+                    CHECK(std::move(chunked).flatten() == values);
+                }
+
+                THEN("leave a moved-from chunked_vector empty") {
+
+                    auto const moved = std::move(chunked);
+
+                    CHECK(chunked.empty());
+                    CHECK(chunked.begin() == chunked.end());
+                    CHECK(moved.flatten() == values);
+                }
+            }
+        }
+
+        AND_GIVEN("a functor instance") {
+
+            AND_GIVEN("fmap") {
+
+                auto to_string = [](auto const v) { return std::to_string(v); };
+
+                WHEN("empty") {
+
+                    chunked_vector<int> const empty;
+
+                    THEN("return an empty chunked_vector") {
+
+                        auto const empty_of_strings = empty | to_string;
+
+                        static_assert(is_same_after_decaying<decltype(empty_of_strings), chunked_vector<std::string>>);
+
+                        CHECK(empty_of_strings.empty());
+                    }
+                }
+
+                WHEN("not empty") {
+
+                    auto const container_of_ints = chunked_vector<int>{1, 2};
+
+                    THEN("return a non-empty chunked_vector containing the mapped values") {
+
+                        auto const container_of_strings = container_of_ints | to_string;
+
+                        static_assert(
+                            is_same_after_decaying<decltype(container_of_strings), chunked_vector<std::string>>);
+
+                        CHECK(container_of_strings == chunked_vector<std::string>{"1", "2"});
+                    }
+                }
+            }
+        }
+
+        AND_GIVEN("an applicative instance") {
+
+            AND_GIVEN("pure") {
+
+                THEN("lift into a non-empty chunked_vector") {
+
+                    auto const singleton = pure<chunked_vector>("1"s);
+
+                    static_assert(is_same_after_decaying<decltype(singleton), chunked_vector<std::string>>);
+
+                    CHECK(singleton == chunked_vector<std::string>{"1"});
+                }
+            }
+
+            AND_GIVEN("combine") {
+
+                WHEN("both are not empty") {
+
+                    auto const first_container = chunked_vector<int>{1, 2};
+                    auto const second_container = chunked_vector<int>{10, 20};
+
+                    THEN("return every combination of their elements") {
+
+                        auto const sum = first_container + second_container;
+
+                        static_assert(is_same_after_decaying<decltype(sum), chunked_vector<int>>);
+
+                        CHECK(sum == chunked_vector<int>{11, 21, 12, 22});
+                    }
+                }
+            }
+        }
+
+        AND_GIVEN("a monad instance") {
+
+            AND_GIVEN("wrap") {
+
+                THEN("lift into a non-empty chunked_vector") {
+
+                    auto const singleton = wrap<chunked_vector>("1"s);
+
+                    static_assert(is_same_after_decaying<decltype(singleton), chunked_vector<std::string>>);
+
+                    CHECK(singleton == chunked_vector<std::string>{"1"});
+                }
+            }
+
+            AND_GIVEN("bind") {
+
+                auto to_chunked_vector_string = [](auto v) {
+                    return chunked_vector<std::string>{std::to_string(v), std::to_string(v)};
+                };
+
+                WHEN("empty") {
+
+                    THEN("return an empty chunked_vector") {
+
+                        auto const empty_of_string = chunked_vector<int>{} >> to_chunked_vector_string;
+
+                        static_assert(is_same_after_decaying<decltype(empty_of_string), chunked_vector<std::string>>);
+
+                        CHECK(empty_of_string.empty());
+                    }
+                }
+
+                WHEN("not empty") {
+
+                    auto const container = chunked_vector<int>{1, 2};
+
+                    THEN("return the short inner results merged into a single chunk") {
+
+                        auto const container_of_string = container >> to_chunked_vector_string;
+
+                        static_assert(
+                            is_same_after_decaying<decltype(container_of_string), chunked_vector<std::string>>);
+
+                        CHECK(container_of_string.chunk_count() == 1);
+                        CHECK(container_of_string == chunked_vector<std::string>{"1", "1", "2", "2"});
+                    }
+                }
+
+                WHEN("there are many short inner results") {
+
+                    auto input = chunked_vector<int>{};
+                    for (int i = 0; i < static_cast<int>(chunked_vector<int>::chunk_size); ++i) {
+                        input.push_back(i);
+                    }
+
+                    THEN("fill full chunks rather than a chunk per inner result") {
+
+                        auto const doubled = input >> [](int v) { return chunked_vector<int>{v, v}; };
+
+                        CHECK(doubled.size() == 2 * chunked_vector<int>::chunk_size);
+                        CHECK(doubled.chunk_count() == 2);
+                    }
+                }
+
+                WHEN("the inner results hold full chunks") {
+
+                    auto const full = chunked_vector<int>(std::vector<int>(chunked_vector<int>::chunk_size, 1));
+
+                    THEN("link their chunks without copying them") {
+
+                        auto const linked = chunked_vector<int>{1, 2, 3} >> [&full](int) { return full; };
+
+                        CHECK(linked.chunk_count() == 3);
+                        CHECK(linked.size() == 3 * chunked_vector<int>::chunk_size);
+                    }
+                }
+
+                WHEN("an inner result is shared") {
+
+                    auto const shared = chunked_vector<int>{7};
+
+                    THEN("link its chunks without changing it") {
+
+                        auto linked = chunked_vector<int>{1, 2} >> [&shared](int) { return shared; };
+                        linked.push_back(8);
+
+                        CHECK(linked == chunked_vector<int>{7, 7, 8});
+                        CHECK(shared == chunked_vector<int>{7});
+                    }
+                }
+            }
+
+            AND_GIVEN("kleisli") {
+
+                THEN("return the same chunked_vector as binding both functions in sequence") {
+
+                    auto const twice = [](int v) { return chunked_vector<int>{v, v}; };
+                    auto const to_string = [](int v) { return chunked_vector<std::string>{std::to_string(v)}; };
+
+                    auto const composed = kleisli<chunked_vector>(twice, to_string);
+
+                    CHECK(composed(1) == (chunked_vector<int>{1} >> twice >> to_string));
+                }
+            }
+        }
+    }
+}
+
+}
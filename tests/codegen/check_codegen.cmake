@@ -0,0 +1,134 @@
+# Compiles the kernels in SOURCE with each compiler in COMPILERS at each optimization level in LEVELS, disassembles
+# them with OBJDUMP, and fails when a codegen::kitten_<name> function is measurably worse than codegen::baseline_<name>:
+#
+#  - it has more than TOLERANCE percent plus SLACK instructions more than the baseline, or
+#  - it allocates or calls into kitten or the kernels' own functions where the baseline doesn't, i.e. the abstraction
+#    wasn't inlined away.
+#
+# Extra calls into the standard library are only reported, since the compilers may keep a slow path such as the
+# growth of a vector out of line in one kernel while inlining it in the other.
+#
+# Usage: cmake -DCOMPILERS=<compilers separated by |> -DOBJDUMP=<path> -DSOURCE=<file> -DINCLUDE_DIR=<dir>
+#              -DWORK_DIR=<dir> -P check_codegen.cmake
+
+cmake_minimum_required(VERSION 3.10)
+
+string(REPLACE "|" ";" COMPILERS "${COMPILERS}")
+
+if (NOT LEVELS)
+    set(LEVELS -O2 -O3)
+endif()
+if (NOT TOLERANCE)
+    set(TOLERANCE 10)
+endif()
+if (NOT SLACK)
+    set(SLACK 4)
+endif()
+
+# Sets <prefix>_NAMES to the kernels found in the disassembly of OBJECT, and <prefix>_<kernel>_INSTRUCTIONS and
+# <prefix>_<kernel>_CALLS to the number of instructions and the sorted list of called functions of each kernel,
+# including its cold clones.
+function(disassemble OBJECT PREFIX)
+    execute_process(
+            COMMAND ${OBJDUMP} -d -r -C --no-show-raw-insn ${OBJECT}
+            OUTPUT_VARIABLE DISASSEMBLY
+            RESULT_VARIABLE RESULT
+    )
+    if (NOT RESULT EQUAL 0)
+        message(FATAL_ERROR "Failed to disassemble ${OBJECT}")
+    endif()
+
+    string(REPLACE ";" "\;" DISASSEMBLY "${DISASSEMBLY}")
+    string(REPLACE "\n" ";" LINES "${DISASSEMBLY}")
+
+    set(NAMES "")
+    set(CURRENT "")
+    foreach (LINE IN LISTS LINES)
+        if (LINE MATCHES "^[0-9a-f]+ <(.*)>:$")
+            set(CURRENT "")
+            if (CMAKE_MATCH_1 MATCHES "^codegen::((kitten|baseline)_[a-z_]+)\\(")
+                set(CURRENT ${CMAKE_MATCH_1})
+                if (NOT CURRENT IN_LIST NAMES)
+                    list(APPEND NAMES ${CURRENT})
+                    set(${CURRENT}_INSTRUCTIONS 0)
+                    set(${CURRENT}_CALLS "")
+                endif()
+            endif()
+        elseif (CURRENT AND LINE MATCHES "^ +[0-9a-f]+:\t")
+            math(EXPR ${CURRENT}_INSTRUCTIONS "${${CURRENT}_INSTRUCTIONS} + 1")
+        elseif (CURRENT AND LINE MATCHES "R_[A-Z0-9_]+_(PLT32|PC32|CALL26|JUMP26|PLT)[ \t]+([^-+]+)")
+            string(STRIP "${CMAKE_MATCH_2}" CALLEE)
+            if (NOT CALLEE MATCHES "^\\.")
+                list(APPEND ${CURRENT}_CALLS "${CALLEE}")
+            endif()
+        endif()
+    endforeach()
+
+    foreach (NAME IN LISTS NAMES)
+        list(REMOVE_DUPLICATES ${NAME}_CALLS)
+        list(SORT ${NAME}_CALLS)
+        set(${PREFIX}_${NAME}_INSTRUCTIONS ${${NAME}_INSTRUCTIONS} PARENT_SCOPE)
+        set(${PREFIX}_${NAME}_CALLS "${${NAME}_CALLS}" PARENT_SCOPE)
+    endforeach()
+    set(${PREFIX}_NAMES ${NAMES} PARENT_SCOPE)
+endfunction()
+
+set(FAILURES 0)
+file(MAKE_DIRECTORY ${WORK_DIR})
+
+foreach (COMPILER IN LISTS COMPILERS)
+    get_filename_component(COMPILER_NAME ${COMPILER} NAME)
+    foreach (LEVEL IN LISTS LEVELS)
+        set(OBJECT ${WORK_DIR}/kernels-${COMPILER_NAME}${LEVEL}.o)
+        execute_process(
+                COMMAND ${COMPILER} -std=c++17 ${LEVEL} -DNDEBUG -I${INCLUDE_DIR} -c ${SOURCE} -o ${OBJECT}
+                RESULT_VARIABLE RESULT
+                ERROR_VARIABLE ERRORS
+        )
+        if (NOT RESULT EQUAL 0)
+            message(FATAL_ERROR "Failed to compile ${SOURCE} with ${COMPILER} ${LEVEL}:\n${ERRORS}")
+        endif()
+
+        disassemble(${OBJECT} CODE)
+
+        foreach (NAME IN LISTS CODE_NAMES)
+            if (NOT NAME MATCHES "^kitten_(.*)$")
+                continue()
+            endif()
+            set(KERNEL ${CMAKE_MATCH_1})
+            set(KITTEN ${CODE_kitten_${KERNEL}_INSTRUCTIONS})
+            set(BASELINE ${CODE_baseline_${KERNEL}_INSTRUCTIONS})
+            if (NOT BASELINE)
+                message(FATAL_ERROR "Kernel kitten_${KERNEL} has no baseline_${KERNEL}")
+            endif()
+            math(EXPR LIMIT "${BASELINE} + ${BASELINE} * ${TOLERANCE} / 100 + ${SLACK}")
+
+            set(EXTRA_CALLS "")
+            set(UNEXPECTED_CALLS "")
+            foreach (CALLEE IN LISTS CODE_kitten_${KERNEL}_CALLS)
+                if (NOT CALLEE IN_LIST CODE_baseline_${KERNEL}_CALLS)
+                    if (CALLEE MATCHES "^(operator new|malloc|calloc|realloc)|rvarago::kitten::|codegen::")
+                        list(APPEND UNEXPECTED_CALLS "${CALLEE}")
+                    else()
+                        list(APPEND EXTRA_CALLS "${CALLEE}")
+                    endif()
+                endif()
+            endforeach()
+
+            set(SUMMARY "${COMPILER_NAME} ${LEVEL} ${KERNEL}: ${KITTEN} instructions (baseline ${BASELINE})")
+            if (KITTEN GREATER LIMIT OR UNEXPECTED_CALLS)
+                math(EXPR FAILURES "${FAILURES} + 1")
+                message("FAIL ${SUMMARY}, unexpected calls: ${UNEXPECTED_CALLS}")
+            else()
+                message("ok   ${SUMMARY}")
+            endif()
+            if (EXTRA_CALLS)
+                message("     extra calls into the standard library: ${EXTRA_CALLS}")
+            endif()
+        endforeach()
+    endforeach()
+endforeach()
+
+if (FAILURES GREATER 0)
+    message(FATAL_ERROR "${FAILURES} kitten kernel(s) compile to worse code than their hand-written baseline")
+endif()
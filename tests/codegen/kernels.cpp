@@ -0,0 +1,96 @@
+// Pairs of kernels, each written once with kitten and once by hand, whose machine code is compared by
+// check_codegen.cmake. A pair is matched by name: codegen::kitten_<name> against codegen::baseline_<name>.
+
+#include <kitten/instances/function.h>
+#include <kitten/instances/optional.h>
+#include <kitten/instances/sequence_container.h>
+#include <kitten/instances/state.h>
+#include <optional>
+#include <vector>
+
+namespace codegen {
+
+using namespace rvarago::kitten;
+
+namespace {
+
+int increment(int v) {
+    return v + 1;
+}
+
+int twice(int v) {
+    return v * 2;
+}
+
+std::optional<int> half(int v) {
+    if (v % 2 != 0) {
+        return std::nullopt;
+    }
+    return v / 2;
+}
+
+}
+
+int kitten_compose(int v) {
+    return (types::fn(increment) | types::fn(twice) | types::fn(increment))(v);
+}
+
+int baseline_compose(int v) {
+    return increment(twice(increment(v)));
+}
+
+std::optional<int> kitten_optional_bind(std::optional<int> const &v) {
+    return v >> half >> half >> half;
+}
+
+std::optional<int> baseline_optional_bind(std::optional<int> const &v) {
+    if (!v.has_value()) {
+        return std::nullopt;
+    }
+    auto const first = half(*v);
+    if (!first.has_value()) {
+        return std::nullopt;
+    }
+    auto const second = half(*first);
+    if (!second.has_value()) {
+        return std::nullopt;
+    }
+    return half(*second);
+}
+
+std::optional<int> kitten_optional_fmap(std::optional<int> const &v) {
+    return v | increment | twice;
+}
+
+std::optional<int> baseline_optional_fmap(std::optional<int> const &v) {
+    if (!v.has_value()) {
+        return std::nullopt;
+    }
+    return twice(increment(*v));
+}
+
+std::vector<int> kitten_vector_fmap(std::vector<int> const &values) {
+    return values | twice;
+}
+
+std::vector<int> baseline_vector_fmap(std::vector<int> const &values) {
+    auto mapped = std::vector<int>{};
+    mapped.reserve(values.size());
+    for (auto const v : values) {
+        mapped.push_back(twice(v));
+    }
+    return mapped;
+}
+
+int kitten_state_bind(int v) {
+    auto const update = [](auto f) { return types::modify_state([f](int &s) { s = f(s); }); };
+    auto const chain = update(increment) >> [&](auto) { return update(twice); } >>
+                       [&](auto) { return update(increment); } >> [](auto) { return types::get_state(); };
+    return chain.eval(v);
+}
+
+int baseline_state_bind(int v) {
+    return increment(twice(increment(v)));
+}
+
+}
@@ -0,0 +1,195 @@
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <kitten/instances/columns.h>
+#include <kitten/instances/variant.h>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "utils.h"
+
+namespace {
+
+using namespace std::string_literals;
+
+using namespace rvarago::kitten;
+using test::utils::is_same_after_decaying;
+using types::columns;
+
+SCENARIO("columns admits multifunctor, functor, and applicative instances", "[columns]") {
+
+    GIVEN("Columns of records") {
+
+        auto const records = columns<int, double, std::string>{std::vector<std::tuple<int, double, std::string>>{
+            {1, 1.5, "a"}, {2, 2.5, "b"}, {3, 3.5, "c"}}};
+
+        THEN("store each field in its own column") {
+
+            CHECK(records.size() == 3);
+            CHECK(records.column<1>() == std::vector<double>{1.5, 2.5, 3.5});
+            CHECK(std::get<2>(records.row(1)) == "b"s);
+            CHECK(&std::get<0>(records.row(2)) == &records.column<0>()[2]);
+            CHECK(records.to_rows().front() == std::tuple{1, 1.5, "a"s});
+        }
+
+        THEN("tell apart iterators into different columns at the same row") {
+
+            auto const copy = records;
+
+            CHECK(records.begin() == records.begin());
+            CHECK(records.begin() != copy.begin());
+        }
+
+        WHEN("built from columns of different sizes") {
+
+            THEN("throw") {
+
+                CHECK_THROWS_AS((columns<int, double>{std::vector<int>{1}, std::vector<double>{}}),
+                                std::invalid_argument);
+            }
+        }
+
+        AND_GIVEN("a multifunctor instance") {
+
+            AND_GIVEN("multimap") {
+
+                THEN("map every column via the overload for its type") {
+
+                    auto const mapped =
+                        records || syntax::overloaded{[](int v) { return static_cast<std::int64_t>(v * 10); },
+                                                      [](double v) { return v * 2; },
+                                                      [](std::string const &v) { return v + v; }};
+
+                    static_assert(
+                        is_same_after_decaying<decltype(mapped), columns<std::int64_t, double, std::string>>);
+
+                    CHECK(mapped.column<0>() == std::vector<std::int64_t>{10, 20, 30});
+                    CHECK(mapped.column<1>() == std::vector<double>{3.0, 5.0, 7.0});
+                    CHECK(mapped.column<2>() == std::vector<std::string>{"aa", "bb", "cc"});
+                }
+            }
+
+            AND_GIVEN("multimap_column") {
+
+                THEN("map only the selected column and share the others") {
+
+                    auto const mapped = multimap_column<1>(records, [](double v) { return std::to_string(v * 2); });
+
+                    static_assert(is_same_after_decaying<decltype(mapped), columns<int, std::string, std::string>>);
+
+                    CHECK(mapped.column<1>() == std::vector<std::string>{"3.000000", "5.000000", "7.000000"});
+                    CHECK(&mapped.column<0>() == &records.column<0>());
+                    CHECK(&mapped.column<2>() == &records.column<2>());
+                }
+
+                AND_WHEN("modifying the result") {
+
+                    auto mapped = multimap_column<1>(records, [](double v) { return v * 2; });
+                    mapped.push_back({4, 9.0, "d"});
+
+                    THEN("leave the input untouched") {
+
+                        CHECK(mapped.size() == 4);
+                        CHECK(records.size() == 3);
+                        CHECK(records.column<2>().back() == "c"s);
+                    }
+                }
+            }
+        }
+
+        AND_GIVEN("a functor instance") {
+
+            AND_GIVEN("fmap") {
+
+                WHEN("the function returns a tuple") {
+
+                    THEN("return a row per result") {
+
+                        auto const mapped = records | [](auto const &row) {
+                            auto const &[id, price, name] = row;
+                            return std::tuple{name, id * price};
+                        };
+
+                        static_assert(is_same_after_decaying<decltype(mapped), columns<std::string, double>>);
+
+                        CHECK(mapped.column<1>() == std::vector<double>{1.5, 5.0, 10.5});
+                    }
+                }
+
+                WHEN("the function returns a single value") {
+
+                    THEN("return a single column") {
+
+                        auto const ids = records | [](auto const &row) { return std::get<0>(row); };
+
+                        static_assert(is_same_after_decaying<decltype(ids), columns<int>>);
+
+                        CHECK(ids.column<0>() == std::vector<int>{1, 2, 3});
+                    }
+                }
+
+                WHEN("the function returns the row it receives") {
+
+                    THEN("copy the rows") {
+
+                        auto const copied = records | [](auto row) { return row; };
+
+                        static_assert(is_same_after_decaying<decltype(copied), columns<int, double, std::string>>);
+
+                        CHECK(copied == records);
+                    }
+                }
+            }
+        }
+
+        AND_GIVEN("an applicative instance") {
+
+            AND_GIVEN("pure") {
+
+                THEN("lift a tuple into a single row") {
+
+                    auto const singleton = pure<columns>(std::tuple{1, "a"s});
+
+                    static_assert(is_same_after_decaying<decltype(singleton), columns<int, std::string>>);
+
+                    CHECK(singleton.size() == 1);
+                }
+
+                THEN("construct a row in place") {
+
+                    auto const from_elements = pure_in_place<columns, std::tuple<int, std::string>>(1, "a");
+                    auto const by_default = pure_in_place<columns, std::tuple<int, std::string>>();
+                    auto const from_tuple = pure_in_place<columns, std::tuple<int, std::string>>(std::pair{2, "b"});
+                    auto const single = pure_in_place<columns, std::string>(3, 'c');
+
+                    static_assert(is_same_after_decaying<decltype(single), columns<std::string>>);
+
+                    CHECK(from_elements.to_rows() == std::vector{std::tuple{1, "a"s}});
+                    CHECK(by_default.to_rows() == std::vector{std::tuple{0, ""s}});
+                    CHECK(from_tuple.to_rows() == std::vector{std::tuple{2, "b"s}});
+                    CHECK(single.column<0>() == std::vector{"ccc"s});
+                }
+            }
+
+            AND_GIVEN("combine") {
+
+                THEN("return every combination of their rows") {
+
+                    auto const factors = columns<int>{std::vector<int>{10, 100}};
+
+                    auto const combined = combine(records, factors, [](auto const &record, auto const &factor) {
+                        return std::get<0>(record) * std::get<0>(factor);
+                    });
+
+                    static_assert(is_same_after_decaying<decltype(combined), columns<int>>);
+
+                    CHECK(combined.column<0>() == std::vector<int>{10, 100, 20, 200, 30, 300});
+                }
+            }
+        }
+    }
+}
+
+}
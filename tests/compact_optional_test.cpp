@@ -0,0 +1,138 @@
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <kitten/instances/compact_optional.h>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "optional_suite.h"
+#include "utils.h"
+
+namespace {
+
+using namespace rvarago::kitten;
+using test::utils::is_same_after_decaying;
+using types::compact_optional;
+
+static_assert(sizeof(compact_optional<std::int64_t>) == sizeof(std::int64_t));
+static_assert(sizeof(compact_optional<double>) == sizeof(double));
+static_assert(sizeof(compact_optional<int const *>) == sizeof(int const *));
+static_assert(std::is_trivially_copyable_v<compact_optional<std::int64_t>>);
+static_assert(std::is_trivially_copyable_v<compact_optional<double>>);
+
+SCENARIO("compact_optional shares the behavior of the optional instances", "[compact_optional]") {
+
+    GIVEN("compact_optional") {
+
+        test::suites::check_optional_instances<compact_optional>();
+        test::suites::check_sentinel_value<compact_optional>(std::numeric_limits<int>::min());
+    }
+}
+
+SCENARIO("compact_optional encodes emptiness as a sentinel", "[compact_optional]") {
+
+    GIVEN("A signed integral type") {
+
+        THEN("its lowest value is the sentinel") {
+
+            CHECK(!compact_optional<int>{}.has_value());
+            CHECK(*compact_optional<int>{} == std::numeric_limits<int>::min());
+            CHECK(compact_optional<int>{std::numeric_limits<int>::min() + 1}.has_value());
+            CHECK(compact_optional<int>{0}.has_value());
+        }
+    }
+
+    GIVEN("An unsigned integral type") {
+
+        THEN("its highest value is the sentinel, whereas 0 is a value") {
+
+            CHECK(!compact_optional<unsigned>{}.has_value());
+            CHECK(*compact_optional<std::size_t>{} == std::numeric_limits<std::size_t>::max());
+            CHECK(*compact_optional<unsigned>{0u} == 0u);
+            CHECK_THROWS_AS(compact_optional<unsigned>{std::numeric_limits<unsigned>::max()}, std::invalid_argument);
+            CHECK((compact_optional<std::size_t>{5} | [](std::size_t v) { return v - 5; }) ==
+                  compact_optional<std::size_t>{0});
+        }
+    }
+
+    GIVEN("Construction in place") {
+
+        THEN("construct the value from the arguments and reject the sentinel") {
+
+            CHECK(*compact_optional<std::uint8_t>{std::in_place, 0} == 0);
+            CHECK_THROWS_AS(compact_optional<std::uint8_t>(std::in_place, 255), std::invalid_argument);
+            CHECK(wrap_in_place<compact_optional, std::size_t>(0u) == compact_optional<std::size_t>{0});
+            CHECK_THROWS_AS((wrap_in_place<compact_optional, int>(std::numeric_limits<int>::min())),
+                            std::invalid_argument);
+        }
+    }
+
+    GIVEN("A floating-point type") {
+
+        THEN("a dedicated NaN is the sentinel, whereas other NaNs are values") {
+
+            CHECK(!compact_optional<double>{}.has_value());
+            CHECK(std::isnan(*compact_optional<double>{}));
+            CHECK(compact_optional<double>{std::numeric_limits<double>::quiet_NaN()}.has_value());
+            CHECK(compact_optional<float>{std::numeric_limits<float>::infinity()}.has_value());
+            CHECK(!compact_optional<float>{}.has_value());
+        }
+    }
+
+    GIVEN("A pointer type") {
+
+        auto const value = 1;
+
+        THEN("nullptr is the sentinel") {
+
+            CHECK(!compact_optional<int const *>{}.has_value());
+            CHECK_THROWS_AS(compact_optional<int const *>{nullptr}, std::invalid_argument);
+            CHECK(**compact_optional<int const *>{&value} == 1);
+        }
+    }
+
+    GIVEN("A user-supplied sentinel") {
+
+        using index = compact_optional<int, types::value_sentinel<-1>>;
+
+        THEN("it's the only empty value") {
+
+            CHECK_THROWS_AS(index{-1}, std::invalid_argument);
+            CHECK(index{std::numeric_limits<int>::min()}.has_value());
+            CHECK(index{} == std::nullopt);
+        }
+
+        THEN("the instances accept it, and create compact_optionals with the default sentinel") {
+
+            auto const next = index{1} | [](int v) { return v + 1; };
+
+            static_assert(is_same_after_decaying<decltype(next), compact_optional<int>>);
+
+            CHECK(next == compact_optional<int>{2});
+            CHECK((index{1} >> [](int v) { return index{v - 1}; }) == index{0});
+            CHECK(!(index{} >> [](int v) { return index{v}; }).has_value());
+        }
+    }
+
+    GIVEN("The accessors") {
+
+        THEN("behave as the ones of std::optional") {
+
+            CHECK_THROWS_AS(compact_optional<int>{}.value(), std::bad_optional_access);
+            CHECK(compact_optional<int>{}.value_or(3) == 3);
+            CHECK(compact_optional<int>{1}.to_optional() == std::optional{1});
+            CHECK(compact_optional<int>{}.to_optional() == std::nullopt);
+
+            auto reset = compact_optional<int>{1};
+            reset.reset();
+            CHECK(!reset);
+        }
+    }
+}
+
+}
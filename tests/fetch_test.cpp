@@ -0,0 +1,160 @@
+#include <catch2/catch.hpp>
+
+#include <kitten/instances/fetch.h>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "utils.h"
+
+namespace {
+
+using namespace std::string_literals;
+
+using namespace rvarago::kitten;
+using test::utils::is_same_after_decaying;
+
+/**
+ * An in-process key-value store that records each batch of keys it's asked for.
+ */
+struct kv_store {
+    std::unordered_map<int, std::string> values;
+    std::vector<std::vector<int>> batches;
+
+    std::vector<std::string> operator()(std::vector<int> const &keys) {
+        batches.push_back(keys);
+        auto found = std::vector<std::string>{};
+        for (auto const key : keys) {
+            found.push_back(values.at(key));
+        }
+        return found;
+    }
+};
+
+SCENARIO("fetch admits functor, applicative, and monad instances", "[fetch]") {
+
+    GIVEN("A data source") {
+
+        auto store = kv_store{{{1, "one"}, {2, "two"}, {3, "three"}, {12, "twelve"}}, {}};
+        auto const names = types::data_source<int, std::string>{[&store](auto const &keys) { return store(keys); }};
+
+        AND_GIVEN("a functor instance") {
+
+            THEN("map over the fetched value") {
+
+                auto const length = names.get(1) | [](std::string const &name) { return name.size(); };
+
+                static_assert(is_same_after_decaying<decltype(length), types::fetch<std::size_t>>);
+
+                CHECK(length.run() == 3);
+                CHECK(names.round_trips() == 1);
+            }
+        }
+
+        AND_GIVEN("an applicative instance") {
+
+            THEN("pure never calls the data source") {
+
+                CHECK(pure<types::fetch>(42).run() == 42);
+                CHECK(names.round_trips() == 0);
+            }
+
+            THEN("combine fetches the lookups of both sides in a single round trip") {
+
+                auto const both = (names.get(1) + names.get(2)) + names.get(3);
+
+                CHECK(both.run() == "onetwothree");
+                CHECK(store.batches == std::vector<std::vector<int>>{{1, 2, 3}});
+            }
+
+            THEN("deduplicate the keys of a round and cache the fetched values") {
+
+                auto const repeated = liftA2<types::fetch>(std::plus<>{})(names.get(1), names.get(1));
+
+                CHECK(repeated.run() == "oneone");
+                CHECK(names.get(1).run() == "one");
+                CHECK(store.batches == std::vector<std::vector<int>>{{1}});
+            }
+
+            THEN("fetch_all fetches every lookup in a single round trip") {
+
+                auto const all = types::fetch_all(std::vector{names.get(3), names.get(2), names.get(3)});
+
+                CHECK(all.run() == std::vector{"three"s, "two"s, "three"s});
+                CHECK(store.batches == std::vector<std::vector<int>>{{3, 2}});
+            }
+
+            THEN("fetch_all fetches many lookups, some of which depend on others, a round trip per dependency") {
+
+                auto const identity = types::data_source<int, int>{[](auto const &keys) { return keys; }};
+                auto fetches = std::vector<types::fetch<int>>{};
+                for (int i = 0; i < 200000; ++i) {
+                    if (i % 2 == 0) {
+                        fetches.push_back(identity.get(i));
+                    } else {
+                        fetches.push_back(identity.get(i) >> [&identity](int v) { return identity.get(-v); });
+                    }
+                }
+
+                auto const values = types::fetch_all(fetches).run();
+
+                REQUIRE(values.size() == 200000);
+                CHECK(values[0] == 0);
+                CHECK(values[1] == -1);
+                CHECK(values[199998] == 199998);
+                CHECK(values[199999] == -199999);
+                CHECK(identity.round_trips() == 2);
+            }
+        }
+
+        AND_GIVEN("a monad instance") {
+
+            THEN("bind starts a new round for the lookups that depend on a fetched value") {
+
+                auto const dependent = names.get(1) >> [&names](std::string const &name) {
+                    return names.get(static_cast<int>(name.size() * 4));
+                };
+
+                static_assert(is_same_after_decaying<decltype(dependent), types::fetch<std::string>>);
+
+                CHECK(dependent.run() == "twelve");
+                CHECK(store.batches == std::vector<std::vector<int>>{{1}, {12}});
+            }
+
+            THEN("independent binds still share their rounds when combined") {
+
+                auto const next = [&names](std::string const &name) { return names.get(name == "one" ? 2 : 3); };
+
+                auto const both = combine(names.get(1) >> next, names.get(2) >> next);
+
+                CHECK(both.run() == "twothree");
+                CHECK(store.batches == std::vector<std::vector<int>>{{1, 2}, {3}});
+            }
+        }
+
+        WHEN("the data source fails") {
+
+            auto const failing = types::data_source<int, int>{[](auto const &) -> std::vector<int> {
+                throw std::runtime_error{"unavailable"};
+            }};
+
+            THEN("rethrow its exception") {
+
+                CHECK_THROWS_AS(failing.get(1).run(), std::runtime_error);
+            }
+        }
+
+        WHEN("the data source misses a value") {
+
+            auto const incomplete = types::data_source<int, int>{[](auto const &) { return std::vector<int>{}; }};
+
+            THEN("throw") {
+
+                CHECK_THROWS_AS(incomplete.get(1).run(), std::invalid_argument);
+            }
+        }
+    }
+}
+
+}
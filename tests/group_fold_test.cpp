@@ -0,0 +1,129 @@
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <kitten/group_fold.h>
+#include <list>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "utils.h"
+
+namespace {
+
+using namespace rvarago::kitten;
+using test::utils::is_same_after_decaying;
+
+SCENARIO("group_fold groups and folds a sequence container in parallel", "[group_fold]") {
+
+    GIVEN("A sequence of values") {
+
+        auto input = std::vector<int>(10000);
+        std::iota(input.begin(), input.end(), 0);
+
+        auto const key = [](int v) { return v % 97; };
+        auto const map = [](int v) { return std::to_string(v) + ","; };
+        auto const concatenate = [](std::string first, std::string const &second) { return first + second; };
+
+        auto expected = std::map<int, std::string>{};
+        for (auto const v : input) {
+            expected[key(v)] += map(v);
+        }
+
+        WHEN("grouping into an unordered map") {
+
+            auto const threads = GENERATE(std::size_t{1}, std::size_t{3}, std::size_t{8});
+
+            auto const groups = group_fold(input, key, map, concatenate, threads);
+
+            static_assert(is_same_after_decaying<decltype(groups), std::unordered_map<int, std::string>>);
+
+            THEN("fold the values of each group in the order of the input") {
+
+                CHECK(groups.size() == expected.size());
+                for (auto const &[k, v] : expected) {
+                    CHECK(groups.at(k) == v);
+                }
+            }
+        }
+
+        WHEN("grouping into a sorted vector") {
+
+            auto const groups = group_fold_sorted(input, key, map, concatenate, 5);
+
+            static_assert(is_same_after_decaying<decltype(groups), std::vector<std::pair<int, std::string>>>);
+
+            THEN("return the groups sorted by key") {
+
+                CHECK(groups == std::vector<std::pair<int, std::string>>(expected.cbegin(), expected.cend()));
+            }
+        }
+
+        WHEN("the sequence isn't random access") {
+
+            auto const words = std::list<std::string>{"kitten", "cat", "koala", "cow", "kitten"};
+
+            auto const lengths = group_fold(
+                words, [](auto const &w) { return w.front(); }, [](auto const &w) { return w.size(); },
+                std::plus<>{}, 4);
+
+            THEN("fold each group") {
+
+                CHECK(lengths == std::unordered_map<char, std::size_t>{{'k', 17}, {'c', 6}});
+            }
+        }
+
+        WHEN("empty") {
+
+            THEN("return no group") {
+
+                CHECK(group_fold(std::vector<int>{}, key, map, concatenate, 4).empty());
+                CHECK(group_fold_sorted(std::vector<int>{}, key, map, concatenate, 4).empty());
+            }
+        }
+
+        WHEN("small") {
+
+            auto const caller = std::this_thread::get_id();
+            auto elsewhere = std::atomic<bool>{false};
+            auto const tracked = [caller, &elsewhere](int v) {
+                if (std::this_thread::get_id() != caller) {
+                    elsewhere = true;
+                }
+                return v % 2;
+            };
+
+            auto const groups = group_fold(
+                std::vector<int>(100, 1), tracked, [](int v) { return v; }, std::plus<>{}, 8);
+
+            THEN("fold it on the calling thread only") {
+
+                CHECK(groups == std::unordered_map<int, int>{{1, 100}});
+                CHECK_FALSE(elsewhere);
+            }
+        }
+
+        WHEN("a function throws") {
+
+            THEN("rethrow its exception") {
+
+                auto const failing = [](int v) {
+                    if (v == 5000) {
+                        throw std::runtime_error{"failed"};
+                    }
+                    return v;
+                };
+
+                CHECK_THROWS_AS(group_fold(input, key, failing, std::plus<>{}, 4), std::runtime_error);
+            }
+        }
+    }
+}
+
+}
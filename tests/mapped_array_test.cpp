@@ -0,0 +1,162 @@
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <kitten/instances/mapped_array.h>
+#include <kitten/instances/sequence_container.h>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "utils.h"
+
+namespace {
+
+using namespace rvarago::kitten;
+using test::utils::is_same_after_decaying;
+using types::mapped_array;
+
+struct record final {
+    std::int32_t id;
+    double price;
+};
+
+class temporary_file final {
+    std::string const location;
+
+  public:
+    template <typename T>
+    explicit temporary_file(std::vector<T> const &records) : location{make_path()} {
+        auto out = std::ofstream{location, std::ios::binary};
+        out.write(reinterpret_cast<char const *>(records.data()), records.size() * sizeof(T));
+    }
+
+    temporary_file() : location{make_path()} {
+    }
+
+    ~temporary_file() {
+        std::remove(location.c_str());
+    }
+
+    std::string const &path() const {
+        return location;
+    }
+
+  private:
+    static std::string make_path() {
+        char name[] = "/tmp/kitten_mapped_array_XXXXXX";
+        ::close(::mkstemp(name));
+        return name;
+    }
+};
+
+SCENARIO("mapped_array admits functor, monad, and foldable instances", "[mapped_array]") {
+
+    GIVEN("A mapped_array") {
+
+        auto const records = std::vector<record>{{1, 1.5}, {2, 2.5}, {3, 3.5}};
+        auto const file = temporary_file{records};
+        auto const mapped = mapped_array<record>{file.path()};
+
+        THEN("expose the records of the file") {
+
+            CHECK(mapped.size() == 3);
+            CHECK(mapped[1].id == 2);
+            CHECK(mapped[2].price == 3.5);
+        }
+
+        AND_GIVEN("an empty file") {
+
+            auto const empty_file = temporary_file{};
+            auto const empty = mapped_array<record>{empty_file.path()};
+
+            THEN("return an empty mapped_array") {
+
+                CHECK(empty.empty());
+                CHECK((empty | [](record const &r) { return r.id; }).empty());
+            }
+        }
+
+        AND_GIVEN("chunks smaller than the file") {
+
+            THEN("feed every record exactly once, in order") {
+
+                auto ids = std::vector<std::int32_t>{};
+                mapped.for_each_chunk(
+                    [&ids](auto first, auto last) {
+                        CHECK(last - first == 1);
+                        for (; first != last; ++first) {
+                            ids.push_back(first->id);
+                        }
+                    },
+                    sizeof(record));
+
+                CHECK(ids == std::vector<std::int32_t>{1, 2, 3});
+            }
+        }
+
+        AND_GIVEN("a functor instance") {
+
+            THEN("fmap into an std::vector") {
+
+                auto const ids = mapped | [](record const &r) { return r.id; };
+
+                static_assert(is_same_after_decaying<decltype(ids), std::vector<std::int32_t>>);
+
+                CHECK(ids == std::vector<std::int32_t>{1, 2, 3});
+            }
+
+            THEN("fmap into a new mapped file") {
+
+                auto const output = temporary_file{};
+                auto const prices = fmap_to_file(mapped, output.path(), [](record const &r) { return r.price * 2; });
+
+                static_assert(is_same_after_decaying<decltype(prices), mapped_array<double>>);
+
+                CHECK(std::vector<double>(prices.begin(), prices.end()) == std::vector<double>{3.0, 5.0, 7.0});
+            }
+
+            THEN("remove the new mapped file if the function throws") {
+
+                auto const output = temporary_file{};
+
+                auto const throw_on_last = [](record const &r) {
+                    if (r.id == 3) {
+                        throw std::runtime_error{"unexpected record"};
+                    }
+                    return r.price;
+                };
+
+                CHECK_THROWS_AS(fmap_to_file(mapped, output.path(), throw_on_last), std::runtime_error);
+                CHECK(::access(output.path().c_str(), F_OK) != 0);
+            }
+        }
+
+        AND_GIVEN("a monad instance") {
+
+            THEN("bind into the sequence container returned by the function") {
+
+                auto const ids = mapped >> [](record const &r) { return std::vector<std::int32_t>(r.id, r.id); };
+
+                static_assert(is_same_after_decaying<decltype(ids), std::vector<std::int32_t>>);
+
+                CHECK(ids == std::vector<std::int32_t>{1, 2, 2, 3, 3, 3});
+            }
+        }
+
+        AND_GIVEN("a foldable instance") {
+
+            THEN("fold every record into a single value") {
+
+                auto const total = fold(mapped, 0.0, [](double acc, record const &r) { return acc + r.price; });
+
+                CHECK(total == 7.5);
+            }
+        }
+    }
+}
+
+}
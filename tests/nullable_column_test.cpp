@@ -0,0 +1,200 @@
+#include <catch2/catch.hpp>
+
+#include <kitten/instances/nullable_column.h>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "utils.h"
+
+namespace {
+
+using namespace rvarago::kitten;
+using test::utils::is_same_after_decaying;
+using types::nullable_column;
+
+SCENARIO("nullable_column admits functor and applicative instances", "[nullable_column]") {
+
+    GIVEN("A nullable_column") {
+
+        AND_GIVEN("conversions") {
+
+            WHEN("built from a vector of optionals") {
+
+                auto const optionals =
+                    std::vector<std::optional<double>>{1.0, std::nullopt, 3.0, std::nullopt, std::nullopt};
+                auto const column = nullable_column<double>{optionals};
+
+                THEN("converting it back returns the same vector of optionals") {
+
+                    CHECK(column.size() == 5);
+                    CHECK(column.has_value(0));
+                    CHECK(!column.has_value(1));
+                    CHECK(column.to_optionals() == optionals);
+                }
+            }
+
+            WHEN("larger than a single word of the validity bitmap") {
+
+                auto optionals = std::vector<std::optional<int>>{};
+                for (int i = 0; i < 130; ++i) {
+                    optionals.push_back(i % 3 == 0 ? std::optional{i} : std::nullopt);
+                }
+                auto const column = nullable_column<int>{optionals};
+
+                THEN("keep the validity of every element") {
+
+                    CHECK(column.validity().size() == 3);
+                    CHECK(column.to_optionals() == optionals);
+                }
+            }
+        }
+
+        AND_GIVEN("a functor instance") {
+
+            AND_GIVEN("fmap") {
+
+                auto times_ten = [](int const v) { return v * 10.0; };
+
+                WHEN("empty") {
+
+                    nullable_column<int> const empty;
+
+                    THEN("return an empty nullable_column") {
+
+                        auto const empty_of_double = empty | times_ten;
+
+                        static_assert(is_same_after_decaying<decltype(empty_of_double), nullable_column<double>>);
+
+                        CHECK(empty_of_double.empty());
+                    }
+                }
+
+                WHEN("not empty") {
+
+                    auto const optionals = std::vector<std::optional<int>>{1, std::nullopt, 3};
+                    auto const column = nullable_column<int>{optionals};
+
+                    THEN("return the same as mapping each optional") {
+
+                        auto const column_of_double = column | times_ten;
+
+                        static_assert(is_same_after_decaying<decltype(column_of_double), nullable_column<double>>);
+
+                        auto expected = std::vector<std::optional<double>>{};
+                        for (auto const &o : optionals) {
+                            expected.push_back(o.has_value() ? std::optional{times_ten(*o)} : std::nullopt);
+                        }
+
+                        CHECK(column_of_double.to_optionals() == expected);
+                    }
+                }
+
+                WHEN("f is partial") {
+
+                    auto const column = nullable_column<int>{{2, std::nullopt, 5}};
+                    auto calls = 0;
+                    auto const ten_over = [&calls](int const v) {
+                        ++calls;
+                        return 10 / v;
+                    };
+
+                    THEN("apply f only to the present values") {
+
+                        auto const quotient = column | ten_over;
+
+                        CHECK(quotient.to_optionals() == std::vector<std::optional<int>>{5, std::nullopt, 2});
+                        CHECK(calls == 2);
+                    }
+                }
+
+                WHEN("f is total") {
+
+                    auto const column = nullable_column<int>{{2, std::nullopt, 5}};
+                    auto calls = 0;
+                    auto const plus_one = types::total{[&calls](int const v) {
+                        ++calls;
+                        return v + 1;
+                    }};
+
+                    THEN("apply f to every value, placeholders included") {
+
+                        auto const successor = column | plus_one;
+
+                        CHECK(successor.to_optionals() == std::vector<std::optional<int>>{3, std::nullopt, 6});
+                        CHECK(calls == 3);
+                    }
+                }
+            }
+        }
+
+        AND_GIVEN("an applicative instance") {
+
+            AND_GIVEN("pure") {
+
+                THEN("lift into a nullable_column with a single present element") {
+
+                    auto const singleton = pure<nullable_column>(42);
+
+                    static_assert(is_same_after_decaying<decltype(singleton), nullable_column<int>>);
+
+                    CHECK(singleton.to_optionals() == std::vector<std::optional<int>>{42});
+                }
+            }
+
+            AND_GIVEN("combine") {
+
+                WHEN("both are not empty") {
+
+                    auto const first = nullable_column<int>{{1, std::nullopt, 3, 4}};
+                    auto const second = nullable_column<int>{{10, 20, std::nullopt, 40}};
+
+                    THEN("return a nullable_column present only where both elements are present") {
+
+                        auto const sum = first + second;
+
+                        static_assert(is_same_after_decaying<decltype(sum), nullable_column<int>>);
+
+                        CHECK(sum.to_optionals() ==
+                              std::vector<std::optional<int>>{11, std::nullopt, std::nullopt, 44});
+                    }
+                }
+
+                WHEN("they have different lengths") {
+
+                    auto const first = nullable_column<int>{{1, 2, 3}};
+                    auto const second = nullable_column<int>{{10}};
+
+                    THEN("return a nullable_column as long as the shortest one") {
+
+                        auto const product_of_string = std::tuple{first, second} + [](int const a, int const b) {
+                            return std::to_string(a * b);
+                        };
+
+                        static_assert(
+                            is_same_after_decaying<decltype(product_of_string), nullable_column<std::string>>);
+
+                        CHECK(product_of_string.to_optionals() == std::vector<std::optional<std::string>>{"10"});
+                    }
+                }
+
+                WHEN("f is partial") {
+
+                    auto const first = nullable_column<int>{{10, std::nullopt, 30}};
+                    auto const second = nullable_column<int>{{2, 0, std::nullopt}};
+
+                    THEN("apply f only where both elements are present") {
+
+                        auto const quotient =
+                            std::tuple{first, second} + [](int const a, int const b) { return a / b; };
+
+                        CHECK(quotient.to_optionals() ==
+                              std::vector<std::optional<int>>{5, std::nullopt, std::nullopt});
+                    }
+                }
+            }
+        }
+    }
+}
+
+}
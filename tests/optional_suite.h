@@ -0,0 +1,131 @@
+#ifndef RVARAGO_KITTEN_TEST_OPTIONAL_SUITE_H
+#define RVARAGO_KITTEN_TEST_OPTIONAL_SUITE_H
+
+#include <catch2/catch.hpp>
+
+#include <kitten/applicative.h>
+#include <kitten/functor.h>
+#include <kitten/monad.h>
+#include <stdexcept>
+
+#include "utils.h"
+
+namespace rvarago::kitten::test::suites {
+
+/**
+ * Checks the behavior that every optional type constructor Optional shares with the instances of std::optional.
+ */
+template <template <typename...> typename Optional>
+void check_optional_instances() {
+    using utils::is_same_after_decaying;
+
+    auto const none = Optional<int>{};
+    auto const some = Optional<int>{2};
+
+    auto const halve = [](int v) { return v / 2.0; };
+    auto const reciprocal = [](int v) { return v == 0 ? Optional<int>{} : Optional<int>{100 / v}; };
+
+    GIVEN("a functor instance") {
+
+        THEN("fmap maps the value of a non-empty optional only") {
+
+            auto const halved = some | halve;
+
+            static_assert(is_same_after_decaying<decltype(halved), Optional<double>>);
+
+            CHECK(halved == Optional<double>{1.0});
+            CHECK(!(none | halve).has_value());
+            CHECK(liftF<Optional>(halve)(some) == Optional<double>{1.0});
+        }
+    }
+
+    GIVEN("an applicative instance") {
+
+        THEN("combine combines two non-empty optionals only") {
+
+            auto const sum = some + Optional<int>{3};
+
+            static_assert(is_same_after_decaying<decltype(sum), Optional<int>>);
+
+            CHECK(sum == Optional<int>{5});
+            CHECK(!(some + none).has_value());
+            CHECK(!(none + some).has_value());
+            CHECK(!(none + none).has_value());
+            CHECK(liftA2<Optional>(std::multiplies<>{})(some, some) == Optional<int>{4});
+        }
+
+        THEN("pure and pure_in_place wrap a value") {
+
+            CHECK(pure<Optional>(1) == Optional<int>{1});
+            CHECK(pure_in_place<Optional, double>(2) == Optional<double>{2.0});
+        }
+    }
+
+    GIVEN("a monad instance") {
+
+        THEN("bind feeds the value of a non-empty optional only") {
+
+            auto const result = some >> reciprocal;
+
+            static_assert(is_same_after_decaying<decltype(result), Optional<int>>);
+
+            CHECK(result == Optional<int>{50});
+            CHECK(!(none >> reciprocal).has_value());
+            CHECK(!(Optional<int>{0} >> reciprocal).has_value());
+        }
+
+        THEN("wrap and wrap_in_place wrap a value") {
+
+            CHECK(wrap<Optional>(1) == Optional<int>{1});
+            CHECK(wrap_in_place<Optional, double>(2) == Optional<double>{2.0});
+        }
+
+        THEN("kleisli short-circuits on the first empty optional") {
+
+            auto const twice = kleisli<Optional>(reciprocal, reciprocal);
+
+            CHECK(twice(2) == Optional<int>{2});
+            CHECK(!twice(0).has_value());
+            CHECK(!twice(200).has_value());
+        }
+
+        THEN("satisfy the monad laws") {
+
+            auto const wrapped = [](int v) { return wrap<Optional>(v); };
+
+            CHECK((wrap<Optional>(4) >> reciprocal) == reciprocal(4));
+            CHECK((some >> wrapped) == some);
+            CHECK((none >> wrapped) == none);
+            CHECK(((some >> reciprocal) >> reciprocal) == (some >> [&](int v) { return reciprocal(v) >> reciprocal; }));
+        }
+    }
+}
+
+
+/**
+ * Checks that an optional type constructor Optional that encodes emptiness as the sentinel of int throws, rather than
+ * yielding an empty optional, whenever it's built, wrapped, mapped, or combined into sentinel.
+ */
+template <template <typename...> typename Optional>
+void check_sentinel_value(int sentinel) {
+    auto const next = Optional<int>{sentinel + 1};
+    auto const decrement = [](int v) { return v - 1; };
+
+    GIVEN("the sentinel as a value") {
+
+        THEN("throw") {
+
+            CHECK_THROWS_AS(Optional<int>{sentinel}, std::invalid_argument);
+            CHECK_THROWS_AS(wrap<Optional>(sentinel), std::invalid_argument);
+            CHECK_THROWS_AS(pure<Optional>(sentinel), std::invalid_argument);
+            CHECK_THROWS_AS(next | decrement, std::invalid_argument);
+            CHECK_THROWS_AS(next + Optional<int>{-1}, std::invalid_argument);
+            CHECK_THROWS_AS(next >> [&decrement](int v) { return wrap<Optional>(decrement(v)); },
+                            std::invalid_argument);
+        }
+    }
+}
+
+}
+
+#endif
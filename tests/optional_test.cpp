@@ -1,8 +1,10 @@
 #include <catch2/catch.hpp>
 
 #include <kitten/instances/optional.h>
+#include <memory>
 #include <string>
 
+#include "optional_suite.h"
 #include "utils.h"
 #include <functional>
 
@@ -103,6 +105,18 @@ SCENARIO("optional admits functor, applicative, and monad instances", "[optional
                 }
             }
 
+            AND_GIVEN("pure_in_place") {
+
+                THEN("construct the value inside a non-empty optional") {
+
+                    auto const some_aaa = pure_in_place<std::optional, std::string>(3, 'a');
+
+                    static_assert(is_same_after_decaying<decltype(some_aaa), std::optional<std::string>>);
+
+                    CHECK(some_aaa.value() == "aaa"s);
+                }
+            }
+
             AND_GIVEN("combine") {
 
                 auto to_product_as_string = [](auto const &a, auto const &b) { return std::to_string(a * b); };
@@ -195,6 +209,21 @@ SCENARIO("optional admits functor, applicative, and monad instances", "[optional
                 }
             }
 
+            AND_GIVEN("wrap_in_place") {
+
+                THEN("construct the value inside a non-empty optional") {
+
+                    auto const some_aaa = wrap_in_place<std::optional, std::string>(3, 'a');
+                    auto const some_ptr = wrap_in_place<std::optional, std::unique_ptr<int>>(new int{1});
+
+                    static_assert(is_same_after_decaying<decltype(some_aaa), std::optional<std::string>>);
+                    static_assert(is_same_after_decaying<decltype(some_ptr), std::optional<std::unique_ptr<int>>>);
+
+                    CHECK(some_aaa.value() == "aaa"s);
+                    CHECK(*some_ptr.value() == 1);
+                }
+            }
+
             AND_GIVEN("bind") {
 
                 auto to_optional_string = [](auto v) { return std::optional{std::to_string(v)}; };
@@ -229,7 +258,68 @@ SCENARIO("optional admits functor, applicative, and monad instances", "[optional
                     }
                 }
             }
+
+            AND_GIVEN("kleisli") {
+
+                auto to_optional_string = [](int v) { return std::optional{std::to_string(v)}; };
+                auto to_optional_int = [](std::string v) { return std::optional{std::stoi(v)}; };
+
+                WHEN("the first function returns an empty optional") {
+
+                    auto const to_none = [](int) -> std::optional<std::string> { return std::nullopt; };
+
+                    THEN("return an empty optional") {
+
+                        auto const composed = kleisli<std::optional>(to_none, to_optional_int);
+                        auto const none = composed(1);
+
+                        static_assert(is_same_after_decaying<decltype(none), std::optional<int>>);
+
+                        CHECK(!none.has_value());
+                    }
+                }
+
+                WHEN("both functions return non-empty optionals") {
+
+                    THEN("return a non-empty optional containing the value bound through both functions") {
+
+                        auto const composed = kleisli<std::optional>(to_optional_string, to_optional_int);
+                        auto const some_one = composed(1);
+
+                        static_assert(is_same_after_decaying<decltype(some_one), std::optional<int>>);
+
+                        CHECK(some_one.has_value());
+                        CHECK(some_one.value() == 1);
+                    }
+                }
+
+                WHEN("the intermediate value is move-only") {
+
+                    auto const to_optional_ptr = [](int v) { return std::optional{std::make_unique<int>(v)}; };
+                    auto const deref = [](std::unique_ptr<int> p) { return std::optional{*p * 10}; };
+
+                    THEN("move it into the second function") {
+
+                        auto const composed = kleisli<std::optional>(to_optional_ptr, deref);
+                        auto const some_ten = composed(1);
+
+                        static_assert(is_same_after_decaying<decltype(some_ten), std::optional<int>>);
+
+                        CHECK(some_ten.has_value());
+                        CHECK(some_ten.value() == 10);
+                    }
+                }
+            }
         }
     }
 }
+
+SCENARIO("optional shares the behavior of the optional instances", "[optional]") {
+
+    GIVEN("std::optional") {
+
+        test::suites::check_optional_instances<std::optional>();
+    }
+}
+
 }
@@ -0,0 +1,217 @@
+#include <catch2/catch.hpp>
+
+#include <kitten/instances/persistent_vector.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "utils.h"
+
+namespace {
+
+using namespace std::string_literals;
+
+using namespace rvarago::kitten;
+using test::utils::is_same_after_decaying;
+using types::persistent_vector;
+
+SCENARIO("persistent_vector admits functor, applicative, and monad instances", "[persistent_vector]") {
+
+    GIVEN("A persistent_vector") {
+
+        AND_GIVEN("several levels of nodes") {
+
+            auto batch = persistent_vector<int>{}.as_transient();
+            for (int i = 0; i < 5000; ++i) {
+                batch.push_back(i);
+            }
+            auto const original = std::move(batch).persistent();
+
+            THEN("keep every value in order") {
+
+                CHECK(original.size() == 5000);
+                CHECK(original[0] == 0);
+                CHECK(original[1056] == 1056);
+                CHECK(original.at(4999) == 4999);
+                CHECK(std::vector<int>(original.begin(), original.end()).back() == 4999);
+            }
+
+            WHEN("updated") {
+
+                auto const updated = original.set(1056, -1).push_back(5000);
+
+                THEN("return a new version and leave the previous one untouched") {
+
+                    CHECK(updated.size() == 5001);
+                    CHECK(updated[1056] == -1);
+                    CHECK(updated[5000] == 5000);
+                    CHECK(original.size() == 5000);
+                    CHECK(original[1056] == 1056);
+                }
+            }
+
+            WHEN("updated through a transient") {
+
+                auto edit = original.as_transient();
+                edit.set(0, -1);
+                edit.set(1, -2);
+                edit.push_back(5000);
+                auto const updated = std::move(edit).persistent();
+
+                THEN("return a new version and leave the previous one untouched") {
+
+                    CHECK(updated[0] == -1);
+                    CHECK(updated[1] == -2);
+                    CHECK(updated.size() == 5001);
+                    CHECK(original[0] == 0);
+                    CHECK(original.size() == 5000);
+                }
+            }
+
+            WHEN("moved from") {
+
+                auto source = original;
+                auto const moved = std::move(source);
+
+                THEN("leave the moved-from persistent_vector empty and usable") {
+
+                    CHECK(moved == original);
+                    CHECK(source.empty());
+                    CHECK(source.begin() == source.end());
+                    CHECK(source.push_back(1) == persistent_vector<int>{1});
+
+                    source = std::move(source);
+
+                    CHECK(source.empty());
+                }
+            }
+
+            WHEN("fmap_sharing") {
+
+                auto calls = 0;
+                auto const negate = [&calls](int v) {
+                    ++calls;
+                    return -v;
+                };
+                auto const negated = fmap_sharing(original, negate, {4999, 1, 1056, 1});
+
+                THEN("map the values at the positions only, each one once") {
+
+                    CHECK(calls == 3);
+                    CHECK(negated.size() == original.size());
+                    CHECK(negated[1] == -1);
+                    CHECK(negated[1056] == -1056);
+                    CHECK(negated[4999] == -4999);
+                    CHECK(negated[0] == 0);
+                    CHECK(negated[1057] == 1057);
+                    CHECK(original[1] == 1);
+                }
+
+                THEN("throw on a position out of bounds") {
+
+                    CHECK_THROWS_AS(fmap_sharing(original, negate, {5000}), std::out_of_range);
+                }
+            }
+        }
+
+        AND_GIVEN("a functor instance") {
+
+            AND_GIVEN("fmap") {
+
+                auto to_string = [](auto const v) { return std::to_string(v); };
+
+                WHEN("empty") {
+
+                    persistent_vector<int> const empty;
+
+                    THEN("return an empty persistent_vector") {
+
+                        auto const empty_of_strings = empty | to_string;
+
+                        static_assert(
+                            is_same_after_decaying<decltype(empty_of_strings), persistent_vector<std::string>>);
+
+                        CHECK(empty_of_strings.empty());
+                    }
+                }
+
+                WHEN("not empty") {
+
+                    auto const container_of_ints = persistent_vector<int>{1, 2};
+
+                    THEN("return a non-empty persistent_vector containing the mapped values") {
+
+                        auto const container_of_strings = container_of_ints | to_string;
+
+                        static_assert(
+                            is_same_after_decaying<decltype(container_of_strings), persistent_vector<std::string>>);
+
+                        CHECK(container_of_strings == persistent_vector<std::string>{"1", "2"});
+                    }
+                }
+            }
+        }
+
+        AND_GIVEN("an applicative instance") {
+
+            AND_GIVEN("pure") {
+
+                THEN("lift into a non-empty persistent_vector") {
+
+                    auto const singleton = pure<persistent_vector>("1"s);
+
+                    static_assert(is_same_after_decaying<decltype(singleton), persistent_vector<std::string>>);
+
+                    CHECK(singleton == persistent_vector<std::string>{"1"});
+                }
+            }
+
+            AND_GIVEN("combine") {
+
+                THEN("return every combination of their elements") {
+
+                    auto const sum = persistent_vector<int>{1, 2} + persistent_vector<int>{10, 20};
+
+                    static_assert(is_same_after_decaying<decltype(sum), persistent_vector<int>>);
+
+                    CHECK(sum == persistent_vector<int>{11, 21, 12, 22});
+                }
+            }
+        }
+
+        AND_GIVEN("a monad instance") {
+
+            AND_GIVEN("wrap") {
+
+                THEN("lift into a non-empty persistent_vector") {
+
+                    auto const singleton = wrap<persistent_vector>("1"s);
+
+                    static_assert(is_same_after_decaying<decltype(singleton), persistent_vector<std::string>>);
+
+                    CHECK(singleton == persistent_vector<std::string>{"1"});
+                }
+            }
+
+            AND_GIVEN("bind") {
+
+                auto to_persistent_vector_string = [](auto v) {
+                    return persistent_vector<std::string>{std::to_string(v), std::to_string(v)};
+                };
+
+                THEN("return the flattened results in order") {
+
+                    auto const container_of_string = persistent_vector<int>{1, 2} >> to_persistent_vector_string;
+
+                    static_assert(
+                        is_same_after_decaying<decltype(container_of_string), persistent_vector<std::string>>);
+
+                    CHECK(container_of_string == persistent_vector<std::string>{"1", "1", "2", "2"});
+                    CHECK((persistent_vector<int>{} >> to_persistent_vector_string).empty());
+                }
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,97 @@
+#include <catch2/catch.hpp>
+
+#include <kitten/pipeline.h>
+#include <list>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "utils.h"
+
+namespace {
+
+using namespace rvarago::kitten;
+using test::utils::is_same_after_decaying;
+
+template <typename Input, typename = void>
+struct can_be_pipelined : std::false_type {};
+
+template <typename Input>
+struct can_be_pipelined<Input, std::void_t<decltype(pipelined(std::declval<Input>()))>> : std::true_type {};
+
+static_assert(can_be_pipelined<std::vector<int> &>::value);
+static_assert(!can_be_pipelined<std::vector<int>>::value, "a pipeline must not reference a temporary input");
+
+SCENARIO("pipeline runs fmap and bind stages concurrently", "[pipeline]") {
+
+    GIVEN("A sequence") {
+
+        auto input = std::vector<int>(1000);
+        std::iota(input.begin(), input.end(), 0);
+
+        auto const parse = [](int v) { return std::to_string(v); };
+        auto const expand = [](std::string const &v) { return std::vector<std::string>{v, v + "!"}; };
+        auto const score = [](std::string const &v) { return v.size(); };
+
+        WHEN("without stages") {
+
+            THEN("collect the input as is") {
+
+                auto const collected = pipelined(input).collect();
+
+                static_assert(is_same_after_decaying<decltype(collected), std::vector<int>>);
+
+                CHECK(collected == input);
+            }
+        }
+
+        WHEN("with fmap and bind stages") {
+
+            THEN("collect the same sequence as running every stage to completion, in order") {
+
+                auto const collected = ((pipelined(input, 7, 2) | parse) >> expand | score).collect();
+
+                static_assert(is_same_after_decaying<decltype(collected), std::vector<std::size_t>>);
+
+                auto expected = std::vector<std::size_t>{};
+                for (auto const v : input) {
+                    for (auto const &e : expand(parse(v))) {
+                        expected.push_back(score(e));
+                    }
+                }
+
+                CHECK(collected == expected);
+            }
+
+            THEN("collect into the requested sequence container") {
+
+                auto const collected = (pipelined(input) | parse).collect<std::list>();
+
+                static_assert(is_same_after_decaying<decltype(collected), std::list<std::string>>);
+
+                CHECK(collected.size() == input.size());
+                CHECK(collected.back() == "999");
+            }
+        }
+
+        WHEN("a stage throws") {
+
+            auto const failing = [](int v) {
+                if (v == 500) {
+                    throw std::runtime_error{"failed"};
+                }
+                return v;
+            };
+
+            THEN("cancel the pipeline and rethrow the exception") {
+
+                CHECK_THROWS_AS((pipelined(input, 4, 1) | failing | parse).collect(), std::runtime_error);
+            }
+        }
+    }
+}
+
+}
@@ -1,10 +1,21 @@
 #include <catch2/catch.hpp>
 
 #include "utils.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iterator>
 #include <kitten/instances/sequence_container.h>
+#include <list>
+#include <memory>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace {
 
@@ -16,6 +27,14 @@ using test::utils::is_same_after_decaying;
 template <typename T, typename Allocator = std::allocator<T>>
 using SequenceContainer = std::vector<T, Allocator>;
 
+template <typename UnaryFunction>
+using string_fmap_result =
+    decltype(functor<std::basic_string>::fmap(std::declval<std::string const &>(), std::declval<UnaryFunction>()));
+
+template <typename BinaryFunction>
+using string_combine_result = decltype(applicative<std::basic_string>::combine(
+    std::declval<std::string const &>(), std::declval<std::string const &>(), std::declval<BinaryFunction>()));
+
 SCENARIO("SequenceContainer admits functor, applicative, and monad instances", "[SequenceContainer]") {
 
     GIVEN("A SequenceContainer") {
@@ -110,6 +129,18 @@ SCENARIO("SequenceContainer admits functor, applicative, and monad instances", "
                 }
             }
 
+            AND_GIVEN("pure_in_place") {
+
+                THEN("construct the value inside a singleton SequenceContainer") {
+
+                    auto const singleton = pure_in_place<SequenceContainer, std::string>(3, 'a');
+
+                    static_assert(is_same_after_decaying<decltype(singleton), SequenceContainer<std::string>>);
+
+                    CHECK(singleton == SequenceContainer<std::string>{"aaa"});
+                }
+            }
+
             AND_GIVEN("combine") {
 
                 auto to_product_as_string = [](auto const &a, auto const &b) {
@@ -209,6 +240,28 @@ SCENARIO("SequenceContainer admits functor, applicative, and monad instances", "
             }
         }
 
+        AND_GIVEN("wrap_in_place") {
+
+            THEN("construct the value inside a singleton SequenceContainer") {
+
+                auto const singleton = wrap_in_place<SequenceContainer, std::string>(3, 'a');
+
+                static_assert(is_same_after_decaying<decltype(singleton), SequenceContainer<std::string>>);
+
+                CHECK(singleton == SequenceContainer<std::string>{"aaa"});
+            }
+
+            THEN("accept move-only values") {
+
+                auto const singleton = wrap<SequenceContainer>(std::make_unique<int>(1));
+
+                static_assert(is_same_after_decaying<decltype(singleton), SequenceContainer<std::unique_ptr<int>>>);
+
+                CHECK(singleton.size() == 1);
+                CHECK(*singleton.front() == 1);
+            }
+        }
+
         AND_GIVEN("bind") {
 
             auto to_SequenceContainer_string = [](auto v) {
@@ -245,6 +298,405 @@ SCENARIO("SequenceContainer admits functor, applicative, and monad instances", "
                 }
             }
         }
+
+        AND_GIVEN("kleisli") {
+
+            auto to_SequenceContainer_int = [](int v) { return SequenceContainer<int>{v, v * 10}; };
+            auto to_SequenceContainer_string = [](int v) {
+                return SequenceContainer<std::string>{std::to_string(v), std::to_string(v + 1)};
+            };
+
+            WHEN("the first function returns an empty SequenceContainer") {
+
+                auto const to_empty = [](int) { return SequenceContainer<int>{}; };
+
+                THEN("return an empty SequenceContainer") {
+
+                    auto const composed = kleisli<SequenceContainer>(to_empty, to_SequenceContainer_string);
+                    auto const empty_of_string = composed(1);
+
+                    static_assert(is_same_after_decaying<decltype(empty_of_string), SequenceContainer<std::string>>);
+
+                    CHECK(empty_of_string.empty());
+                }
+            }
+
+            WHEN("both functions return non-empty SequenceContainers") {
+
+                THEN("return the same SequenceContainer as binding both functions in sequence") {
+
+                    auto const composed =
+                        kleisli<SequenceContainer>(to_SequenceContainer_int, to_SequenceContainer_string);
+                    auto const container_of_string = composed(1);
+
+                    static_assert(
+                        is_same_after_decaying<decltype(container_of_string), SequenceContainer<std::string>>);
+
+                    CHECK(container_of_string == SequenceContainer<std::string>{"1", "2", "10", "11"});
+                    CHECK(container_of_string ==
+                          (SequenceContainer<int>{1} >> to_SequenceContainer_int >> to_SequenceContainer_string));
+                }
+            }
+        }
+    }
+
+    AND_GIVEN("filter_map") {
+
+        auto to_half_if_even = [](int v) { return v % 2 == 0 ? std::optional{v / 2} : std::nullopt; };
+        auto to_string_if_even = [](int v) { return v % 2 == 0 ? std::optional{std::to_string(v)} : std::nullopt; };
+
+        WHEN("empty") {
+
+            SequenceContainer<int> const empty;
+
+            THEN("return an empty SequenceContainer") {
+
+                auto const filtered = filter_map(empty, to_half_if_even);
+
+                static_assert(is_same_after_decaying<decltype(filtered), SequenceContainer<int>>);
+
+                CHECK(filtered.empty());
+            }
+        }
+
+        WHEN("not empty") {
+
+            auto const container = SequenceContainer<int>{1, 2, 3, 4, 6};
+
+            THEN("return the values of the non-empty optionals, in order") {
+
+                auto const halves = filter_map(container, to_half_if_even);
+                auto const strings = filter_map(container, to_string_if_even);
+
+                static_assert(is_same_after_decaying<decltype(halves), SequenceContainer<int>>);
+                static_assert(is_same_after_decaying<decltype(strings), SequenceContainer<std::string>>);
+
+                CHECK(halves == SequenceContainer<int>{1, 2, 3});
+                CHECK(strings == SequenceContainer<std::string>{"2", "4", "6"});
+            }
+        }
+    }
+
+    AND_GIVEN("filter") {
+
+        auto const container = SequenceContainer<int>{1, 2, 3, 4, 6};
+
+        THEN("return only the values that satisfy the predicate, in order") {
+
+            auto const odds = filter(container, [](int v) { return v % 2 != 0; });
+            auto const none = filter(container, [](int) { return false; });
+            auto const strings = filter(SequenceContainer<std::string>{"a", "", "b"}, [](auto const &v) {
+                return !v.empty();
+            });
+
+            CHECK(odds == SequenceContainer<int>{1, 3});
+            CHECK(none.empty());
+            CHECK(strings == SequenceContainer<std::string>{"a", "b"});
+        }
+
+        THEN("keep booleans too") {
+
+            auto const flags = SequenceContainer<bool>{true, false, true};
+            auto const negated_if_true = [](bool v) { return v ? std::optional{!v} : std::nullopt; };
+
+            CHECK(filter(flags, [](bool v) { return v; }) == SequenceContainer<bool>{true, true});
+            CHECK(filter_map(flags, negated_if_true) == SequenceContainer<bool>{false, false});
+        }
+    }
+
+    AND_GIVEN("a foldable instance") {
+
+        AND_GIVEN("fold") {
+
+            auto to_concatenated = [](std::string acc, int v) { return acc + std::to_string(v); };
+
+            WHEN("empty") {
+
+                SequenceContainer<int> const empty;
+
+                THEN("return the initial value") {
+
+                    CHECK(fold(empty, "0"s, to_concatenated) == "0"s);
+                }
+            }
+
+            WHEN("not empty") {
+
+                auto const container = SequenceContainer<int>{1, 2, 3};
+
+                THEN("accumulate every value from left to right") {
+
+                    CHECK(fold(container, "0"s, to_concatenated) == "0123"s);
+                }
+            }
+        }
+    }
+
+    AND_GIVEN("a comonad instance") {
+
+        auto const container = SequenceContainer<int>{1, 2, 3, 4};
+
+        AND_GIVEN("extract") {
+
+            THEN("return the first value") {
+
+                CHECK(extract(container) == 1);
+            }
+        }
+
+        AND_GIVEN("extend") {
+
+            auto to_size = [](auto const &suffix) { return suffix.size(); };
+
+            THEN("feed every suffix into the function") {
+
+                auto const sizes = extend(container, to_size);
+
+                static_assert(is_same_after_decaying<decltype(sizes), SequenceContainer<std::size_t>>);
+
+                CHECK(sizes == SequenceContainer<std::size_t>{4, 3, 2, 1});
+            }
+
+            THEN("obey the comonad laws") {
+
+                auto to_extracted = [](auto const &suffix) { return extract(suffix); };
+
+                auto to_extended = [&to_size](auto const &suffix) { return extract(extend(suffix, to_size)); };
+
+                CHECK(extend(container, to_extracted) == container);
+                CHECK(extract(extend(container, to_size)) == to_size(container));
+                CHECK(extend(extend(container, to_size), to_extracted) == extend(container, to_extended));
+
+                auto const last = duplicate(container).back();
+                CHECK(std::vector<int>(last.begin(), last.end()) == std::vector<int>{4});
+            }
+
+            THEN("feed views over the suffixes rather than copies of them") {
+
+                auto const firsts = extend(container, [](auto const &suffix) { return &suffix.front(); });
+
+                CHECK(firsts == SequenceContainer<int const *>{&container[0], &container[1], &container[2],
+                                                               &container[3]});
+            }
+        }
+
+        AND_GIVEN("extend_windowed") {
+
+            auto to_sum = [](auto const &window) {
+                return fold(SequenceContainer<int>(window.begin(), window.end()), 0, std::plus<>{});
+            };
+
+            WHEN("shorter than the window") {
+
+                THEN("return an empty sequence container") {
+
+                    CHECK(extend_windowed(container, 5, to_sum).empty());
+                }
+            }
+
+            WHEN("at least as long as the window") {
+
+                THEN("feed every window into the function") {
+
+                    auto const sums = extend_windowed(container, 2, to_sum);
+
+                    static_assert(is_same_after_decaying<decltype(sums), SequenceContainer<int>>);
+
+                    CHECK(sums == SequenceContainer<int>{3, 5, 7});
+                    CHECK(extend_windowed(container, 4, to_sum) == SequenceContainer<int>{10});
+                }
+            }
+
+            WHEN("the window is empty") {
+
+                THEN("throw") {
+
+                    CHECK_THROWS_AS(extend_windowed(container, 0, to_sum), std::invalid_argument);
+                }
+            }
+
+            AND_GIVEN("an invertible monoid") {
+
+                auto const sum = types::invertible_monoid{0, std::plus<>{}, std::negate<>{}};
+
+                THEN("aggregate every window incrementally") {
+
+                    auto const sums = extend_windowed(container, 3, sum);
+
+                    static_assert(is_same_after_decaying<decltype(sums), SequenceContainer<int>>);
+
+                    CHECK(sums == SequenceContainer<int>{6, 9});
+                    CHECK(extend_windowed(container, 5, sum).empty());
+                    CHECK(extend_windowed(std::list<int>{1, 2, 3, 4}, 2, sum) == std::list<int>{3, 5, 7});
+                }
+
+                THEN("keep the values of each window in order when the monoid isn't commutative") {
+
+                    // x -> a * x + b, where a is 1 or -1, applying the left one first.
+                    using affine = std::pair<int, int>;
+                    auto const then = [](affine const &f, affine const &g) {
+                        return affine{g.first * f.first, g.first * f.second + g.second};
+                    };
+                    auto const compositions =
+                        types::invertible_monoid{affine{1, 0}, then, [](affine const &f) {
+                                                     return affine{f.first, -f.first * f.second};
+                                                 }};
+                    auto const maps = std::vector<affine>{{-1, 1}, {1, 2}, {-1, 3}, {-1, 4}, {1, 5}};
+
+                    auto expected = std::vector<affine>{};
+                    for (std::size_t i = 0; i + 3 <= maps.size(); ++i) {
+                        expected.push_back(then(then(maps[i], maps[i + 1]), maps[i + 2]));
+                    }
+
+                    CHECK(extend_windowed(maps, 3, compositions) == expected);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("std::basic_string admits functor, applicative, and monad instances", "[SequenceContainer]") {
+
+    GIVEN("A std::string") {
+
+        auto const text = std::string{"Kitten says Hello!"};
+
+        THEN("admit the combinators of the sequence containers") {
+
+            CHECK(wrap<std::basic_string>('a') == "a"s);
+            CHECK((text >> [](char c) { return std::string(2, c); }).substr(0, 4) == "KKii"s);
+            CHECK(filter(text, [](char c) { return c != ' '; }) == "KittensaysHello!"s);
+        }
+
+        AND_GIVEN("a byte function") {
+
+            auto to_lower = [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); };
+
+            WHEN("short") {
+
+                THEN("map every byte") {
+
+                    auto const lowered = text | to_lower;
+
+                    static_assert(is_same_after_decaying<decltype(lowered), std::string>);
+
+                    CHECK(lowered == "kitten says hello!"s);
+                }
+            }
+
+            WHEN("long") {
+
+                auto long_text = std::string{};
+                for (int i = 0; i < 1000; ++i) {
+                    long_text.push_back(static_cast<char>(i * 7));
+                }
+
+                THEN("map every byte as if one at a time") {
+
+                    auto expected = std::string{};
+                    std::transform(long_text.begin(), long_text.end(), std::back_inserter(expected), to_lower);
+
+                    CHECK((long_text | to_lower) == expected);
+                }
+            }
+        }
+
+        AND_GIVEN("a long text and a stateless validator that throws on non-ASCII bytes") {
+
+            auto const long_text = std::string(1000, 'k');
+            auto validate = [](char c) {
+                if (static_cast<unsigned char>(c) > 127) {
+                    throw std::invalid_argument{"non-ASCII byte"};
+                }
+                return c;
+            };
+
+            THEN("call it only on the bytes in the text") {
+
+                CHECK_NOTHROW(long_text | validate);
+            }
+        }
+
+        THEN("reject mapping and combining into non-character types") {
+
+            static_assert(std::is_void_v<string_fmap_result<int (*)(char)>>);
+            static_assert(std::is_void_v<string_fmap_result<std::string (*)(char)>>);
+            static_assert(is_same_after_decaying<string_fmap_result<char16_t (*)(char)>, std::u16string>);
+            static_assert(std::is_void_v<string_combine_result<std::plus<>>>);
+            static_assert(is_same_after_decaying<string_combine_result<char (*)(char, char)>, std::string>);
+        }
+    }
+
+    GIVEN("A vector of bytes") {
+
+        auto bytes = std::vector<std::uint8_t>(1001);
+        for (std::size_t i = 0; i < bytes.size(); ++i) {
+            bytes[i] = static_cast<std::uint8_t>(i * 31);
+        }
+
+        AND_GIVEN("a lookup table") {
+
+            auto entries = std::array<std::uint8_t, 256>{};
+            for (std::size_t i = 0; i < entries.size(); ++i) {
+                entries[i] = static_cast<std::uint8_t>(255 - i);
+            }
+            auto const invert = types::lookup_table<std::uint8_t>{entries};
+
+            THEN("map every byte to its entry") {
+
+                auto const inverted = bytes | invert;
+
+                static_assert(is_same_after_decaying<decltype(inverted), std::vector<std::uint8_t>>);
+
+                auto expected = std::vector<std::uint8_t>{};
+                std::transform(bytes.begin(), bytes.end(), std::back_inserter(expected),
+                               [](std::uint8_t v) { return static_cast<std::uint8_t>(255 - v); });
+
+                CHECK(inverted == expected);
+            }
+
+            THEN("tabulate a function") {
+
+                auto const mask = types::lookup_table<std::uint8_t>::from([](std::uint8_t v) {
+                    return static_cast<std::uint8_t>(v & 0x7F);
+                });
+
+                CHECK((bytes | mask)[3] == static_cast<std::uint8_t>(93 & 0x7F));
+            }
+
+            THEN("look every byte up alike on the vectorized kernel, when the CPU has it, and on the scalar one") {
+
+                auto scalar = std::vector<std::uint8_t>(bytes.size());
+                detail::simd::lookup_scalar(bytes.data(), bytes.size(), scalar.data(), invert.bytes());
+
+                auto dispatched = std::vector<std::uint8_t>(bytes.size());
+                detail::simd::lookup(bytes.data(), bytes.size(), dispatched.data(), invert.bytes());
+                CHECK(dispatched == scalar);
+
+                if (detail::simd::supports_avx512vbmi()) {
+                    auto vectorized = std::vector<std::uint8_t>(bytes.size());
+                    auto const done =
+                        detail::simd::lookup_avx512vbmi(bytes.data(), bytes.size(), vectorized.data(), invert.bytes());
+
+                    CHECK(done == bytes.size() / 64 * 64);
+                    CHECK(std::equal(vectorized.begin(), vectorized.begin() + done, scalar.begin()));
+                }
+            }
+
+            THEN("map a sequence longer than a chunk of the lookup") {
+
+                auto long_bytes = std::vector<std::uint8_t>(10007);
+                for (std::size_t i = 0; i < long_bytes.size(); ++i) {
+                    long_bytes[i] = static_cast<std::uint8_t>(i * 7);
+                }
+
+                auto expected = std::vector<std::uint8_t>{};
+                std::transform(long_bytes.begin(), long_bytes.end(), std::back_inserter(expected),
+                               [](std::uint8_t v) { return static_cast<std::uint8_t>(255 - v); });
+
+                CHECK((long_bytes | invert) == expected);
+            }
+        }
     }
 }
 }
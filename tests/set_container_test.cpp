@@ -0,0 +1,151 @@
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <kitten/instances/set_container.h>
+#include <set>
+#include <string>
+#include <unordered_set>
+
+#include "utils.h"
+
+namespace {
+
+using namespace std::string_literals;
+
+using namespace rvarago::kitten;
+using test::utils::is_same_after_decaying;
+
+/**
+ * A value that counts how many times it was copied.
+ */
+struct copy_counted {
+    static inline std::size_t copies = 0;
+
+    int value;
+
+    explicit copy_counted(int v) : value{v} {
+    }
+
+    copy_counted(copy_counted const &other) : value{other.value} {
+        ++copies;
+    }
+
+    copy_counted &operator=(copy_counted const &other) {
+        value = other.value;
+        ++copies;
+        return *this;
+    }
+
+    friend bool operator<(copy_counted const &first, copy_counted const &second) {
+        return first.value < second.value;
+    }
+};
+
+SCENARIO("std::unordered_set admits functor, applicative, and monad instances", "[set_container]") {
+
+    using set = std::unordered_set<int>;
+
+    GIVEN("fmap") {
+
+        THEN("drop the values mapped into duplicates") {
+
+            auto const parities = set{1, 2, 3, 4} | [](int v) { return v % 2; };
+
+            static_assert(is_same_after_decaying<decltype(parities), set>);
+
+            CHECK(parities == set{0, 1});
+            CHECK((set{} | [](int v) { return std::to_string(v); }).empty());
+        }
+    }
+
+    GIVEN("combine") {
+
+        THEN("drop the combinations that yield duplicates") {
+
+            CHECK((set{1, 2} + set{10, 20}) == set{11, 12, 21, 22});
+            CHECK((set{1, 2} + set{2, 1}) == set{2, 3, 4});
+        }
+    }
+
+    GIVEN("wrap") {
+
+        THEN("return a singleton") {
+
+            CHECK(wrap<std::unordered_set>("a"s) == std::unordered_set<std::string>{"a"});
+        }
+    }
+
+    GIVEN("bind") {
+
+        auto const neighbours = [](int v) { return set{v - 1, v, v + 1}; };
+
+        THEN("return the distinct values of the inner sets") {
+
+            auto const frontier = set{1, 2, 3} >> neighbours;
+
+            static_assert(is_same_after_decaying<decltype(frontier), set>);
+
+            CHECK(frontier == set{0, 1, 2, 3, 4});
+            CHECK((set{} >> neighbours).empty());
+            CHECK((set{1, 2} >> [](int) { return set{}; }).empty());
+        }
+
+        THEN("compose the expansions via kleisli") {
+
+            CHECK(kleisli<std::unordered_set>(neighbours, neighbours)(0) == set{-2, -1, 0, 1, 2});
+        }
+    }
+}
+
+SCENARIO("std::set admits functor, applicative, and monad instances", "[set_container]") {
+
+    using set = std::set<int>;
+
+    GIVEN("fmap, combine, and pure") {
+
+        THEN("drop duplicates") {
+
+            CHECK((set{1, 2, 3, 4} | [](int v) { return v % 2; }) == set{0, 1});
+            CHECK((set{1, 2} + set{2, 1}) == set{2, 3, 4});
+            CHECK(pure<std::set>(1) == set{1});
+        }
+    }
+
+    GIVEN("bind") {
+
+        auto const neighbours = [](int v) { return set{v - 1, v + 1}; };
+
+        THEN("return the distinct values of the inner sets in order") {
+
+            CHECK((set{1, 3} >> neighbours) == set{0, 2, 4});
+            CHECK(kleisli<std::set>(neighbours, neighbours)(0) == set{-2, 0, 2});
+        }
+    }
+}
+
+SCENARIO("bind moves the nodes of the inner sets rather than copying their values", "[set_container]") {
+
+    GIVEN("a function that returns a new set per value") {
+
+        auto const expand = [](int v) {
+            auto inner = std::set<copy_counted>{};
+            inner.emplace(v);
+            inner.emplace(v + 1);
+            return inner;
+        };
+
+        WHEN("binding") {
+
+            copy_counted::copies = 0;
+            auto const expanded = std::set<int>{1, 2, 3} >> expand;
+
+            THEN("never copy a value") {
+
+                CHECK(expanded.size() == 4);
+                CHECK(copy_counted::copies == 0);
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,181 @@
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <kitten/instances/spilled_sequence.h>
+#include <vector>
+
+#include "utils.h"
+
+namespace {
+
+using namespace rvarago::kitten;
+using test::utils::count_allocations;
+using test::utils::is_same_after_decaying;
+using types::spilled_sequence;
+
+template <typename T>
+std::vector<T> collect(spilled_sequence<T> const &sequence) {
+    auto collected = std::vector<T>{};
+    sequence.for_each_chunk([&collected](auto first, auto last) { collected.insert(collected.end(), first, last); });
+    return collected;
+}
+
+SCENARIO("spilled_sequence admits functor, monad, and foldable instances", "[spilled_sequence]") {
+
+    GIVEN("A bind with a memory budget") {
+
+        auto const users = std::vector<std::int32_t>{1, 2, 3, 4, 5};
+        auto to_events = [](std::int32_t user) { return std::vector<std::int64_t>(user, user); };
+
+        WHEN("the output exceeds the budget") {
+
+            auto const events = bind_with_budget(users, to_events, 4 * sizeof(std::int64_t));
+
+            static_assert(is_same_after_decaying<decltype(events), spilled_sequence<std::int64_t>>);
+
+            THEN("spill the completed chunks to disk and keep the same values in order") {
+
+                CHECK(events.size() == 15);
+                CHECK(events.spilled_size() == 12);
+                CHECK(collect(events) == (users >> to_events));
+            }
+
+            AND_WHEN("fmap") {
+
+                auto const doubled = events | [](std::int64_t v) { return static_cast<double>(v) * 2; };
+
+                static_assert(is_same_after_decaying<decltype(doubled), spilled_sequence<double>>);
+
+                THEN("stream the values into a new spilled_sequence with the same budget") {
+
+                    CHECK(doubled.size() == 15);
+                    CHECK(doubled.memory_budget() == events.memory_budget());
+                    CHECK(collect(doubled).back() == 10.0);
+                }
+            }
+
+            AND_WHEN("bind") {
+
+                auto const repeated = events >> [](std::int64_t v) { return std::vector<std::int64_t>{v, -v}; };
+
+                THEN("stream the values into a new spilled_sequence") {
+
+                    CHECK(repeated.size() == 30);
+                    CHECK(fold(repeated, std::int64_t{0}, std::plus<>{}) == 0);
+                }
+            }
+
+            AND_WHEN("bind into spilled_sequences") {
+
+                auto const pairs = events >> [](std::int64_t v) {
+                    auto pair = wrap<spilled_sequence>(v);
+                    pair.push_back(-v);
+                    return pair;
+                };
+
+                THEN("stream the values of every inner spilled_sequence") {
+
+                    CHECK(pairs.size() == 30);
+                    CHECK(pairs.memory_budget() == events.memory_budget());
+                    CHECK(fold(pairs, std::int64_t{0}, std::plus<>{}) == 0);
+                }
+            }
+
+            AND_WHEN("kleisli") {
+
+                auto const twice = [](std::int64_t v) {
+                    auto pair = wrap<spilled_sequence>(v);
+                    pair.push_back(v);
+                    return pair;
+                };
+                auto const negated = [](std::int64_t v) { return wrap<spilled_sequence>(-v); };
+
+                THEN("return the same as binding both functions in sequence") {
+
+                    CHECK(collect(kleisli<spilled_sequence>(twice, negated)(3)) == std::vector<std::int64_t>{-3, -3});
+                    CHECK(collect(wrap<spilled_sequence>(std::int64_t{3}) >> twice >> negated) ==
+                          std::vector<std::int64_t>{-3, -3});
+                }
+            }
+
+            AND_WHEN("fold") {
+
+                THEN("accumulate every value from left to right") {
+
+                    CHECK(fold(events, std::int64_t{0}, std::plus<>{}) == 55);
+                }
+            }
+        }
+
+        WHEN("the output fills the budget exactly") {
+
+            auto const events = bind_with_budget(users, to_events, 15 * sizeof(std::int64_t));
+
+            THEN("never spill") {
+
+                CHECK(events.size() == 15);
+                CHECK(events.spilled_size() == 0);
+            }
+        }
+
+        WHEN("moved from") {
+
+            auto events = bind_with_budget(users, to_events, 4 * sizeof(std::int64_t));
+            auto const moved = std::move(events);
+
+            THEN("leave the moved-from spilled_sequence empty and usable") {
+
+                CHECK(moved.size() == 15);
+                CHECK(collect(moved) == (users >> to_events));
+                CHECK(events.empty());
+                CHECK(collect(events).empty());
+
+                for (std::int64_t v = 0; v < 5; ++v) {
+                    events.push_back(v);
+                }
+
+                CHECK(events.spilled_size() == 4);
+                CHECK(collect(events) == std::vector<std::int64_t>{0, 1, 2, 3, 4});
+            }
+        }
+
+        WHEN("the output fits in the budget") {
+
+            auto const events = bind_with_budget(users, to_events, 1024);
+
+            THEN("never spill") {
+
+                CHECK(events.size() == 15);
+                CHECK(events.spilled_size() == 0);
+                CHECK(collect(events) == (users >> to_events));
+            }
+        }
+    }
+
+    GIVEN("A few records and the default memory budget") {
+
+        THEN("grow the records kept in memory with the sequence rather than allocating the whole budget") {
+
+            auto single = spilled_sequence<std::int64_t>{1};
+            auto const wrapping = count_allocations([&single] { single = wrap<spilled_sequence>(std::int64_t{42}); });
+
+            CHECK(collect(single) == std::vector<std::int64_t>{42});
+            CHECK(wrapping.bytes < 1024);
+
+            auto ten = spilled_sequence<std::int64_t>{spilled_sequence<std::int64_t>::default_memory_budget};
+            for (std::int64_t i = 0; i < 10; ++i) {
+                ten.push_back(i);
+            }
+            auto doubled = spilled_sequence<std::int64_t>{1};
+            auto const mapping =
+                count_allocations([&] { doubled = ten | [](std::int64_t v) { return 2 * v; }; });
+
+            CHECK(collect(doubled).back() == 18);
+            CHECK(mapping.bytes < 1024);
+        }
+    }
+}
+
+}
@@ -0,0 +1,147 @@
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <kitten/instances/state.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "utils.h"
+
+namespace {
+
+using namespace std::string_literals;
+
+using namespace rvarago::kitten;
+using test::utils::is_same_after_decaying;
+
+/**
+ * A vector of values that counts how many times it was copied.
+ */
+struct copy_counted {
+    static inline std::size_t copies = 0;
+
+    std::vector<int> values;
+
+    copy_counted() = default;
+
+    copy_counted(copy_counted const &other) : values{other.values} {
+        ++copies;
+    }
+
+    copy_counted(copy_counted &&) noexcept = default;
+
+    copy_counted &operator=(copy_counted const &other) {
+        values = other.values;
+        ++copies;
+        return *this;
+    }
+
+    copy_counted &operator=(copy_counted &&) noexcept = default;
+};
+
+SCENARIO("state admits functor, applicative, and monad instances", "[state]") {
+
+    GIVEN("A counter") {
+
+        auto const tick = types::make_state([](int &&counter) { return std::pair{counter, counter + 1}; });
+
+        THEN("run yields the value and the final state") {
+
+            CHECK(tick.run(0) == std::pair{0, 1});
+            CHECK(tick.eval(5) == 5);
+            CHECK(tick.exec(5) == 6);
+        }
+
+        AND_GIVEN("a functor instance") {
+
+            THEN("map the value and keep the state") {
+
+                auto const label = tick | [](int v) { return "#"s + std::to_string(v); };
+
+                CHECK(label.run(7) == std::pair{"#7"s, 8});
+            }
+        }
+
+        AND_GIVEN("an applicative instance") {
+
+            THEN("combine runs the first and then the second computation") {
+
+                auto const pair_of_ticks = combine(tick, tick, [](int a, int b) { return std::pair{a, b}; });
+
+                CHECK(pair_of_ticks.run(0) == std::pair{std::pair{0, 1}, 2});
+                CHECK((tick + tick).run(10) == std::pair{21, 12});
+            }
+
+            THEN("pure yields the value and leaves the state untouched") {
+
+                CHECK(pure<types::state>(42).run(3) == std::pair{42, 3});
+                CHECK(pure_in_place<types::state, std::string>(2, 'a').run(0) == std::pair{"aa"s, 0});
+            }
+        }
+
+        AND_GIVEN("a monad instance") {
+
+            THEN("bind threads the state into the computation returned by f") {
+
+                auto const skip = tick >> [](int v) { return types::put_state(v * 10); } >>
+                                  [](auto) { return types::get_state(); };
+
+                CHECK(skip.run(2) == std::pair{20, 20});
+            }
+
+            THEN("satisfy the monad laws") {
+
+                auto const f = [&tick](int v) { return tick | [v](int w) { return v + w; }; };
+
+                CHECK((wrap<types::state>(1) >> f).run(5) == f(1).run(5));
+                CHECK((tick >> [](int v) { return wrap<types::state>(v); }).run(5) == tick.run(5));
+                CHECK(((tick >> f) >> f).run(0) == (tick >> [&f](int v) { return f(v) >> f; }).run(0));
+            }
+
+            THEN("kleisli composes state computations") {
+
+                auto const f = [&tick](int v) { return tick | [v](int w) { return v * w; }; };
+
+                CHECK(kleisli<types::state>(f, f)(2).run(3) == std::pair{24, 5});
+            }
+        }
+    }
+
+    GIVEN("A large state") {
+
+        auto const push = [](int v) { return types::modify_state([v](copy_counted &s) { s.values.push_back(v); }); };
+        auto const size = types::select_state([](copy_counted const &s) { return s.values.size(); });
+
+        WHEN("threaded through a chain of binds") {
+
+            auto const chain = push(1) >> [&](auto) { return push(2); } >> [&](auto) { return push(3); } >>
+                               [&](auto) { return size; };
+
+            copy_counted::copies = 0;
+            auto [count, final_state] = chain.run(copy_counted{});
+
+            THEN("update it in place without copying it") {
+
+                CHECK(count == 3);
+                CHECK(final_state.values == std::vector{1, 2, 3});
+                CHECK(copy_counted::copies == 0);
+            }
+        }
+    }
+
+    GIVEN("A move-only state") {
+
+        auto const increment = types::modify_state([](std::unique_ptr<int> &s) { ++*s; });
+
+        THEN("thread it by move") {
+
+            auto const twice = increment >> [&increment](auto) { return increment; };
+
+            CHECK(*twice.exec(std::make_unique<int>(1)) == 3);
+        }
+    }
+}
+
+}
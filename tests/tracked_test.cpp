@@ -0,0 +1,145 @@
+#include <catch2/catch.hpp>
+
+#include <kitten/instances/tracked.h>
+#include <string>
+#include <vector>
+
+#include "utils.h"
+
+namespace {
+
+using namespace rvarago::kitten;
+using types::tracked;
+
+SCENARIO("tracked admits incremental fmap and combine", "[tracked]") {
+
+    GIVEN("A tracked vector") {
+
+        auto prices = tracked<std::vector<int>>{std::vector<int>(10000, 1)};
+
+        auto calls = std::size_t{0};
+        auto to_string = [&calls](int v) {
+            ++calls;
+            return std::to_string(v);
+        };
+
+        auto repriced = std::vector<std::string>{};
+        fmap_incremental(prices, to_string, repriced);
+        prices.clear_dirty();
+
+        THEN("compute every value at first") {
+
+            CHECK(calls == 10000);
+            CHECK(repriced == std::vector<std::string>(10000, "1"));
+            CHECK(prices.dirty_count() == 0);
+        }
+
+        WHEN("a few values are modified") {
+
+            calls = 0;
+            prices.set(0, 2);
+            prices.set(4097, 3);
+            prices.update(9999, [](int &v) { v += 3; });
+            prices.set(4097, 5);
+
+            THEN("mark them as dirty") {
+
+                CHECK(prices.dirty_count() == 3);
+                CHECK(prices.is_dirty(4097));
+                CHECK_FALSE(prices.is_dirty(4096));
+
+                auto dirty = std::vector<std::size_t>{};
+                prices.for_each_dirty([&dirty](std::size_t i) { dirty.push_back(i); });
+                CHECK(dirty == std::vector<std::size_t>{0, 4097, 9999});
+            }
+
+            THEN("recompute only the modified values") {
+
+                fmap_incremental(prices, to_string, repriced);
+
+                CHECK(calls == 3);
+                CHECK(repriced[0] == "2");
+                CHECK(repriced[4097] == "5");
+                CHECK(repriced[9999] == "4");
+                CHECK(repriced[1] == "1");
+            }
+
+            AND_WHEN("cleared") {
+
+                prices.clear_dirty();
+
+                THEN("mark every value as clean") {
+
+                    CHECK(prices.dirty_count() == 0);
+                    CHECK_FALSE(prices.is_dirty(4097));
+                }
+            }
+        }
+
+        WHEN("too many values are modified") {
+
+            calls = 0;
+            for (std::size_t i = 0; i < 5000; ++i) {
+                prices.set(i, 7);
+            }
+            fmap_incremental(prices, to_string, repriced);
+
+            THEN("recompute every value") {
+
+                CHECK(calls == 10000);
+                CHECK(repriced[4999] == "7");
+                CHECK(repriced[5000] == "1");
+            }
+        }
+
+        WHEN("every value is replaced") {
+
+            calls = 0;
+            prices.assign(std::vector<int>(3, 9));
+            fmap_incremental(prices, to_string, repriced);
+
+            THEN("recompute every value") {
+
+                CHECK(calls == 3);
+                CHECK(repriced == std::vector<std::string>(3, "9"));
+            }
+        }
+    }
+
+    GIVEN("Two tracked vectors") {
+
+        auto first = tracked<std::vector<int>>{std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8}};
+        auto second = tracked<std::vector<int>>{std::vector<int>{10, 20, 30, 40, 50, 60, 70, 80}};
+
+        auto calls = std::size_t{0};
+        auto sum = [&calls](int a, int b) {
+            ++calls;
+            return a + b;
+        };
+
+        auto sums = std::vector<int>{};
+        combine_incremental(first, second, sum, sums);
+        first.clear_dirty();
+        second.clear_dirty();
+
+        WHEN("a value of each is modified") {
+
+            calls = 0;
+            first.set(1, 100);
+            second.set(2, 300);
+            combine_incremental(first, second, sum, sums);
+
+            THEN("recompute only the affected row and column") {
+
+                CHECK(calls == 15);
+                CHECK(sums[1 * 8 + 0] == 110);
+                CHECK(sums[1 * 8 + 2] == 400);
+                CHECK(sums[0 * 8 + 2] == 301);
+                CHECK(sums[0 * 8 + 0] == 11);
+                CHECK(sums.size() == 64);
+            }
+        }
+    }
+}
+
+}
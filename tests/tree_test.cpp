@@ -0,0 +1,140 @@
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <kitten/instances/tree.h>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "utils.h"
+
+namespace {
+
+using namespace std::string_literals;
+
+using namespace rvarago::kitten;
+using test::utils::is_same_after_decaying;
+using types::tree;
+
+SCENARIO("tree admits functor, monad, and foldable instances", "[tree]") {
+
+    GIVEN("A tree") {
+
+        // 1 has the children 2, 5, and 6, and 2 has the children 3 and 4
+        auto const numbers = tree{1, {tree{2, {tree{3}, tree{4}}}, tree{5}, tree{6}}};
+
+        THEN("lay out its nodes in preorder") {
+
+            CHECK(numbers.values() == std::vector{1, 2, 3, 4, 5, 6});
+            CHECK(numbers.subtree_size(0) == 6);
+            CHECK(numbers.subtree_size(1) == 3);
+            CHECK(numbers.subtree(1) == tree{2, {tree{3}, tree{4}}});
+
+            auto children = std::vector<std::size_t>{};
+            numbers.for_each_child(0, [&children](std::size_t child) { children.push_back(child); });
+            CHECK(children == std::vector<std::size_t>{1, 4, 5});
+        }
+
+        THEN("be built from its values and subtree sizes in preorder") {
+
+            CHECK(tree<int>::from_preorder({1, 2, 3, 4, 5, 6}, {6, 3, 1, 1, 1, 1}) == numbers);
+            CHECK(tree<int>::from_preorder({}, {}).empty());
+            CHECK_THROWS_AS(tree<int>::from_preorder({1, 2}, {2}), std::invalid_argument);
+            CHECK_THROWS_AS(tree<int>::from_preorder({1, 2}, {1, 1}), std::invalid_argument);
+            CHECK_THROWS_AS(tree<int>::from_preorder({1, 2, 3}, {3, 1, 2}), std::invalid_argument);
+            CHECK_THROWS_AS(tree<int>::from_preorder({1, 2, 3}, {3, 0, 1}), std::invalid_argument);
+        }
+
+        AND_GIVEN("a functor instance") {
+
+            THEN("map every value and keep the shape") {
+
+                auto const strings = numbers | [](int v) { return std::to_string(v); };
+
+                static_assert(is_same_after_decaying<decltype(strings), tree<std::string>>);
+
+                CHECK(strings == tree{"1"s, {tree{"2"s, {tree{"3"s}, tree{"4"s}}}, tree{"5"s}, tree{"6"s}}});
+                CHECK(strings.same_shape(numbers));
+                CHECK((tree<int>{} | [](int v) { return v; }).empty());
+            }
+
+            THEN("fmap_parallel maps like fmap does") {
+
+                auto const twice = [](int v) { return v * 2; };
+
+                CHECK(fmap_parallel(numbers, twice, 4) == (numbers | twice));
+                CHECK(fmap_parallel(numbers, twice, 64) == (numbers | twice));
+            }
+        }
+
+        AND_GIVEN("a monad instance") {
+
+            THEN("graft the tree returned for each value in place of its node") {
+
+                auto const expanded = numbers >> [](int v) {
+                    return v % 2 == 0 ? tree{v, {tree{-v}}} : tree{v};
+                };
+
+                static_assert(is_same_after_decaying<decltype(expanded), tree<int>>);
+
+                CHECK(expanded ==
+                      tree{1, {tree{2, {tree{-2}, tree{3}, tree{4, {tree{-4}}}}}, tree{5}, tree{6, {tree{-6}}}}});
+            }
+
+            THEN("satisfy the identity laws") {
+
+                CHECK((numbers >> [](int v) { return wrap<tree>(v); }) == numbers);
+                CHECK((wrap<tree>(1) >> [&numbers](int) { return numbers; }) == numbers);
+                CHECK(wrap_in_place<tree, std::string>(3, 'a') == tree{"aaa"s});
+            }
+
+            THEN("throw when f returns an empty tree") {
+
+                CHECK_THROWS_AS(numbers >> [](int) { return tree<int>{}; }, std::invalid_argument);
+            }
+        }
+
+        AND_GIVEN("a foldable instance") {
+
+            THEN("fold the values in preorder") {
+
+                CHECK(fold(numbers, ""s, [](auto acc, int v) { return acc + std::to_string(v); }) == "123456");
+            }
+        }
+    }
+
+    GIVEN("A large tree") {
+
+        auto leaves = std::vector<tree<int>>(10000, tree{1});
+        auto const large = tree{0, std::vector<tree<int>>(10, tree{0, leaves})};
+
+        THEN("fmap_parallel maps every node") {
+
+            auto const mapped = fmap_parallel(large, [](int v) { return v + 1; }, 3);
+
+            CHECK(std::accumulate(mapped.values().cbegin(), mapped.values().cend(), 0) == 100011 + 100000);
+        }
+    }
+
+    GIVEN("A deep tree") {
+
+        auto const depth = std::size_t{40000};
+        auto sizes = std::vector<std::size_t>(depth);
+        std::iota(sizes.rbegin(), sizes.rend(), std::size_t{1});
+        auto const chain = tree<int>::from_preorder(std::vector<int>(depth, 1), std::move(sizes));
+
+        THEN("bind grafts every node without recursing per level") {
+
+            auto const expanded = chain >> [](int v) { return tree{v, {tree{-v}}}; };
+
+            REQUIRE(expanded.size() == 2 * depth);
+            CHECK(expanded.subtree_size(0) == 2 * depth);
+            CHECK(expanded.subtree_size(1) == 1);
+            CHECK(expanded.subtree_size(2) == 2 * depth - 2);
+            CHECK(expanded.subtree_size(2 * depth - 1) == 1);
+        }
+    }
+}
+
+}
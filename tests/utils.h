@@ -1,10 +1,113 @@
 #ifndef RVARAGO_KITTEN_TEST_UTILS_H
 #define RVARAGO_KITTEN_TEST_UTILS_H
 
+#include <cstddef>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
 namespace rvarago::kitten::test::utils {
 
 template <typename T1, typename T2>
 inline constexpr bool is_same_after_decaying = std::is_same<std::decay_t<T1>, std::decay_t<T2>>::value;
+
+/**
+ * Number of allocations and of bytes requested.
+ */
+struct allocations {
+    std::size_t count{0};
+    std::size_t bytes{0};
+};
+
+/**
+ * @return the allocations made so far by the calling thread via the global operator new, which is replaced in
+ * allocation_counting.cpp
+ */
+allocations thread_allocations() noexcept;
+
+/**
+ * Runs action and returns the allocations that it made on the calling thread via the global operator new.
+ *
+ * Values to be kept should be created outside of action and assigned inside of it, so that only the allocations made
+ * by the operation under test are counted.
+ */
+template <typename Action>
+allocations count_allocations(Action &&action) {
+    auto const before = thread_allocations();
+    std::forward<Action>(action)();
+    auto const after = thread_allocations();
+    return {after.count - before.count, after.bytes - before.bytes};
+}
+
+/**
+ * A memory resource that forwards to upstream, while counting the allocations and deallocations made through it.
+ */
+class counting_resource : public std::pmr::memory_resource {
+  public:
+    explicit counting_resource(std::pmr::memory_resource *upstream = std::pmr::new_delete_resource()) noexcept
+        : upstream{upstream} {
+    }
+
+    allocations allocated() const noexcept {
+        return allocated_;
+    }
+
+    std::size_t deallocated() const noexcept {
+        return deallocated_;
+    }
+
+  private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        auto *p = upstream->allocate(bytes, alignment);
+        ++allocated_.count;
+        allocated_.bytes += bytes;
+        return p;
+    }
+
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override {
+        upstream->deallocate(p, bytes, alignment);
+        ++deallocated_;
+    }
+
+    bool do_is_equal(std::pmr::memory_resource const &other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource *upstream;
+    allocations allocated_;
+    std::size_t deallocated_{0};
+};
+
+/**
+ * @return the allocations made by pushing size values, one at a time, into an empty Container, i.e. the number of times
+ * that its growth policy reallocates
+ */
+template <typename Container>
+std::size_t growth_allocations(std::size_t size) {
+    auto container = Container{};
+    return count_allocations([&] {
+               for (std::size_t i = 0; i < size; ++i) {
+                   container.emplace_back();
+               }
+           })
+        .count;
+}
+
+/**
+ * @return the allocations made by creating an empty Container and then pushing size values into it, one at a time,
+ * which, unlike growth_allocations, includes whatever the constructor allocates upfront, e.g. the map of an std::deque
+ */
+template <typename Container>
+std::size_t filling_allocations(std::size_t size) {
+    return count_allocations([&] {
+               auto container = Container{};
+               for (std::size_t i = 0; i < size; ++i) {
+                   container.emplace_back();
+               }
+           })
+        .count;
+}
+
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -2,6 +2,7 @@
 
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <kitten/instances/variant.h>
 
@@ -62,6 +63,58 @@ SCENARIO("variant admits a multifunctor instance", "[variant]") {
             }
         }
     }
+
+    GIVEN("A sequence of variants") {
+
+        auto const choices = std::vector<std::variant<int, std::string, double>>{1, "a", 2.5, 2, "b"};
+
+        auto choices_mapper = syntax::overloaded{[](int v) { return v * 10; }, [](std::string v) { return v + v; },
+                                                 [](double v) { return static_cast<long>(v * 2); }};
+
+        WHEN("batch_multimap") {
+
+            THEN("return the same sequence as mapping every variant in order") {
+
+                auto const mapped = batch_multimap(choices, choices_mapper);
+
+                static_assert(is_same_after_decaying<decltype(mapped),
+                                                     std::vector<std::variant<int, std::string, long>>>);
+
+                auto expected = std::vector<std::variant<int, std::string, long>>{};
+                for (auto const &choice : choices) {
+                    expected.push_back(choice || choices_mapper);
+                }
+
+                CHECK(mapped == expected);
+                CHECK(mapped[2].index() == 2);
+            }
+        }
+
+        WHEN("batch_multimap_grouped") {
+
+            THEN("return the mapped values grouped by choice, each group in order") {
+
+                auto const [ints, strings, longs] = batch_multimap_grouped(choices, choices_mapper);
+
+                CHECK(ints == std::vector<int>{10, 20});
+                CHECK(strings == std::vector<std::string>{"aa", "bb"});
+                CHECK(longs == std::vector<long>{5});
+            }
+        }
+
+        WHEN("the mapped variant is not default constructible") {
+
+            auto to_error = syntax::overloaded{[](int v) { return error_t{v}; }, [](auto const &) { return 0; }};
+
+            THEN("still return the mapped variants in order") {
+
+                auto const mapped = batch_multimap(choices, to_error);
+
+                CHECK(std::get<0>(mapped[3]).code == 2);
+                CHECK(std::get<1>(mapped[4]) == 0);
+            }
+        }
+    }
 }
 
 }
\ No newline at end of file